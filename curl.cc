@@ -4,56 +4,8 @@
 #include <err.h>
 #include <cstring>
 #include <cinttypes>
-#include <limits>
 
 namespace curl {
-constexpr auto curl_t::Version::from(std::uint8_t major, std::uint8_t minor, std::uint8_t patch) noexcept -> 
-    Version
-{
-    return {static_cast<std::uint32_t>(major << 16) | 
-            static_cast<std::uint32_t>(minor << 8)  | 
-            static_cast<std::uint32_t>(patch)};
-}
-
-static constexpr const auto mask = std::numeric_limits<std::uint8_t>::max();
-constexpr std::uint8_t curl_t::Version::get_major() const noexcept
-{
-    return (num >> 16) & mask;
-}
-constexpr std::uint8_t curl_t::Version::get_minor() const noexcept
-{
-    return (num >> 8) & mask;
-}
-constexpr std::uint8_t curl_t::Version::get_patch() const noexcept
-{
-    return num & mask;
-}
-
-constexpr bool operator <  (const curl_t::Version &x, const curl_t::Version &y) noexcept
-{
-    return x.num < y.num;
-}
-constexpr bool operator <= (const curl_t::Version &x, const curl_t::Version &y) noexcept
-{
-    return x.num <= y.num;
-}
-constexpr bool operator >  (const curl_t::Version &x, const curl_t::Version &y) noexcept
-{
-    return x.num > y.num;
-}
-constexpr bool operator >= (const curl_t::Version &x, const curl_t::Version &y) noexcept
-{
-    return x.num >= y.num;
-}
-constexpr bool operator == (const curl_t::Version &x, const curl_t::Version &y) noexcept
-{
-    return x.num == y.num;
-}
-constexpr bool operator != (const curl_t::Version &x, const curl_t::Version &y) noexcept
-{
-    return x.num != y.num;
-}
-
 std::size_t curl_t::Version::to_string(char buffer[12]) const noexcept
 {
     return std::snprintf(buffer, 12, "%" PRIu8 ".%" PRIu8 ".%" PRIu8, get_major(), get_minor(), get_patch());
@@ -190,6 +142,10 @@ bool curl_t::has_pause_support() const noexcept
 {
     return version >= Version::from(7, 18, 0);
 }
+bool curl_t::has_xferinfo_support() const noexcept
+{
+    return version >= Version::from(7, 32, 0);
+}
 
 bool curl_t::has_header_option_support() const noexcept
 {
@@ -204,6 +160,10 @@ bool curl_t::has_redirect_url_support() const noexcept
 {
     return version >= Version::from(7, 18, 2);
 }
+bool curl_t::has_microsecond_timing_support() const noexcept
+{
+    return version >= Version::from(7, 61, 0);
+}
 
 bool curl_t::has_getinfo_cookie_list_support() const noexcept
 {
@@ -237,6 +197,10 @@ bool curl_t::has_multi_socket_support() const noexcept
 {
     return version >= Version::from(7, 16, 0);
 }
+bool curl_t::has_multi_wakeup_support() const noexcept
+{
+    return version >= Version::from(7, 68, 0);
+}
 
 bool curl_t::has_http2_multiplex_support() const noexcept
 {
@@ -5,6 +5,7 @@
 # include <cstdio>
 # include <stdexcept>
 # include <memory>
+# include <limits>
 
 # include "return-exception/ret-exception.hpp"
 
@@ -252,11 +253,17 @@ public:
 
     bool has_readfunc_abort_support() const noexcept;
     bool has_pause_support() const noexcept;
+    bool has_xferinfo_support() const noexcept;
 
     bool has_header_option_support() const noexcept;
     bool has_set_ip_addr_only_support() const noexcept;
 
     bool has_redirect_url_support() const noexcept;
+    /**
+     * Whether timings of a transfer can be retrieved in microseconds,
+     * see Easy_ref_t::getinfo_transfer_report().
+     */
+    bool has_microsecond_timing_support() const noexcept;
 
     bool has_getinfo_cookie_list_support() const noexcept;
 
@@ -320,6 +327,22 @@ public:
      * easy must not be used in any way during this function call.
      */
     auto dup_easy(const Easy_t &easy, std::size_t buffer_size = 0) noexcept -> Easy_t;
+    /**
+     * @param easy must not be nullptr
+     * @param buffer_size same as create_easy
+     *
+     * Re-initializes all options previously set on easy to the default values
+     * via curl_easy_reset, then applies the same defaults create_easy would set.
+     *
+     * Live connections, the Session ID cache, the DNS cache, the cookies
+     * and shares are kept.
+     *
+     * As long as stderr_stream and disable_signal_handling_v is not modified
+     * when reset_easy is called, this function is thread-safe.
+     *
+     * easy must not be used in any way during this function call.
+     */
+    void reset_easy(const Easy_t &easy, std::size_t buffer_size = 0) noexcept;
 
     /**
      * has curl::Url support
@@ -356,6 +379,7 @@ public:
 
     bool has_multi_poll_support() const noexcept;
     bool has_multi_socket_support() const noexcept;
+    bool has_multi_wakeup_support() const noexcept;
 
     /**
      * http2 multiplex is turn on by default, if supported.
@@ -390,6 +414,52 @@ public:
     auto create_share() noexcept -> Share_t;
 };
 
+constexpr auto curl_t::Version::from(std::uint8_t major, std::uint8_t minor, std::uint8_t patch) noexcept -> 
+    Version
+{
+    return {static_cast<std::uint32_t>(major << 16) | 
+            static_cast<std::uint32_t>(minor << 8)  | 
+            static_cast<std::uint32_t>(patch)};
+}
+
+constexpr std::uint8_t curl_t::Version::get_major() const noexcept
+{
+    return (num >> 16) & std::numeric_limits<std::uint8_t>::max();
+}
+constexpr std::uint8_t curl_t::Version::get_minor() const noexcept
+{
+    return (num >> 8) & std::numeric_limits<std::uint8_t>::max();
+}
+constexpr std::uint8_t curl_t::Version::get_patch() const noexcept
+{
+    return num & std::numeric_limits<std::uint8_t>::max();
+}
+
+constexpr bool operator <  (const curl_t::Version &x, const curl_t::Version &y) noexcept
+{
+    return x.num < y.num;
+}
+constexpr bool operator <= (const curl_t::Version &x, const curl_t::Version &y) noexcept
+{
+    return x.num <= y.num;
+}
+constexpr bool operator >  (const curl_t::Version &x, const curl_t::Version &y) noexcept
+{
+    return x.num > y.num;
+}
+constexpr bool operator >= (const curl_t::Version &x, const curl_t::Version &y) noexcept
+{
+    return x.num >= y.num;
+}
+constexpr bool operator == (const curl_t::Version &x, const curl_t::Version &y) noexcept
+{
+    return x.num == y.num;
+}
+constexpr bool operator != (const curl_t::Version &x, const curl_t::Version &y) noexcept
+{
+    return x.num != y.num;
+}
+
 using Easy_t = curl_t::Easy_t;
 using Url_t = curl_t::Url_t;
 using Share_t = curl_t::Share_t;
@@ -0,0 +1,137 @@
+#include "curl_blocking_client.hpp"
+
+#include <climits>
+#include <utility>
+
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+namespace curl {
+static void futex_wait(std::atomic<std::uint32_t> &word, std::uint32_t expected) noexcept
+{
+    syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), FUTEX_WAIT_PRIVATE, expected,
+            nullptr, nullptr, 0);
+}
+static void futex_wake(std::atomic<std::uint32_t> &word) noexcept
+{
+    syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), FUTEX_WAKE_PRIVATE, INT_MAX,
+            nullptr, nullptr, 0);
+}
+
+Blocking_client::Blocking_client(curl_t &curl_arg) noexcept:
+    curl{curl_arg}
+{}
+
+void Blocking_client::set_share(Share_base *share_arg) noexcept
+{
+    share = share_arg;
+}
+void Blocking_client::set_multiplexing(long max_concurrent_stream_arg) noexcept
+{
+    max_concurrent_stream = max_concurrent_stream_arg;
+}
+
+auto Blocking_client::start() noexcept -> Ret_except<void, std::system_error, curl::Exception>
+{
+    bool failed = false;
+    auto result = curl.create_multi();
+    result.Catch([&](curl::Exception) noexcept { failed = true; });
+    if (failed)
+        return {curl::Exception{"In curl::Blocking_client::start: curl_multi_init failed"}};
+    multi = std::move(result).get_return_value();
+
+    if (max_concurrent_stream != -1)
+        multi.set_multiplexing(max_concurrent_stream);
+
+    int err = pthread_create(&thread, nullptr, loop_main, this);
+    if (err != 0)
+        return {std::system_error{err, std::generic_category(),
+                                  "In curl::Blocking_client::start: pthread_create failed"}};
+    started = true;
+
+    return {};
+}
+
+auto Blocking_client::perform(Easy_ref_t &easy_ref) noexcept -> Easy_ref_t::perform_ret_t
+{
+    Waiter waiter;
+    waiter.saved_private = easy_ref.get_private();
+    easy_ref.set_private(&waiter);
+
+    if (share)
+        share->add_easy(easy_ref);
+
+    // The handle is still owned by the caller, the queue only hands it over.
+    Easy_t easy{easy_ref.curl_easy};
+
+    bool oom = false;
+    inbox.push(easy).Catch([&](std::bad_alloc) noexcept { oom = true; });
+    if (oom) {
+        easy.release();
+        if (share)
+            share->remove_easy(easy_ref);
+        easy_ref.set_private(waiter.saved_private);
+        return {std::bad_alloc{}};
+    }
+
+    while (waiter.done.load(std::memory_order_acquire) == 0)
+        futex_wait(waiter.done, 0);
+
+    easy_ref.set_private(waiter.saved_private);
+
+    return std::move(waiter.result);
+}
+
+void Blocking_client::run() noexcept
+{
+    auto on_finished = [](Easy_ref_t &easy_ref, Easy_ref_t::perform_ret_t ret, Multi_t &multi,
+                          void*) noexcept
+    {
+        multi.remove_easy(easy_ref);
+
+        auto &waiter = *static_cast<Waiter*>(easy_ref.get_private());
+        waiter.result = std::move(ret);
+
+        waiter.done.store(1, std::memory_order_release);
+        // Waking up a waiter that has already returned is harmless
+        futex_wake(waiter.done);
+    };
+
+    for (;;) {
+        // Read stopping before draining, so that requests submitted before stop() is called
+        // are never left behind.
+        const bool stop = stopping.load(std::memory_order_acquire);
+
+        inbox.drain();
+        multi.perform(on_finished, nullptr).get_return_value();
+
+        if (stop && multi.get_number_of_handles() == 0)
+            break;
+
+        multi.poll(nullptr, 0, default_poll_timeout).get_return_value();
+    }
+}
+void* Blocking_client::loop_main(void *arg) noexcept
+{
+    static_cast<Blocking_client*>(arg)->run();
+    return nullptr;
+}
+
+void Blocking_client::stop() noexcept
+{
+    if (!started)
+        return;
+
+    stopping.store(true, std::memory_order_release);
+
+    multi.wakeup();
+    pthread_join(thread, nullptr);
+    started = false;
+}
+
+Blocking_client::~Blocking_client()
+{
+    stop();
+}
+} /* namespace curl */
@@ -0,0 +1,125 @@
+#ifndef  __curl_cpp_curl_blocking_client_HPP__
+# define __curl_cpp_curl_blocking_client_HPP__
+
+# include "curl.hpp"
+# include "curl_easy.hpp"
+# include "curl_multi.hpp"
+# include "curl_share.hpp"
+# include "curl_submission_queue.hpp"
+
+# include <cstdint>
+# include <atomic>
+# include <new>
+# include <system_error>
+
+# include <pthread.h>
+
+namespace curl {
+/**
+ * @example curl_blocking_client.cc
+ *
+ * Blocking_client is a drop-in replacement of Easy_ref_t::perform() for code
+ * making blocking requests from many threads.
+ *
+ * perform() hands the transfer to a Multi_t run by a background thread and
+ * parks the calling thread on a futex until it is done, so that all callers share
+ * one connection cache (and HTTP/2 multiplexing) while staying synchronous.
+ *
+ * Errors of the event loop, i.e. out of memory or bug in libcurl,
+ * are fatal.
+ *
+ * @pre curl_t::has_multi_poll_support() && curl_t::has_multi_wakeup_support() &&
+ *      curl_t::has_private_ptr_support()
+ */
+class Blocking_client {
+public:
+    static constexpr const long default_poll_timeout = 1000;
+
+protected:
+    /**
+     * Lives on the stack of the thread calling perform().
+     */
+    struct Waiter {
+        void *saved_private;
+        Easy_ref_t::perform_ret_t result{Easy_ref_t::code::ok};
+        /**
+         * Futex word, set to 1 once result is set.
+         */
+        std::atomic<std::uint32_t> done{0};
+    };
+
+    curl_t &curl;
+
+    Multi_t multi;
+    Submission_queue inbox{multi};
+
+    pthread_t thread;
+    bool started = false;
+
+    Share_base *share = nullptr;
+    long max_concurrent_stream = -1;
+
+    std::atomic<bool> stopping{false};
+
+    static void* loop_main(void *arg) noexcept;
+    void run() noexcept;
+
+public:
+    Blocking_client(curl_t &curl) noexcept;
+
+    Blocking_client(const Blocking_client&) = delete;
+    Blocking_client(Blocking_client&&) = delete;
+
+    Blocking_client& operator = (const Blocking_client&) = delete;
+    Blocking_client& operator = (Blocking_client&&) = delete;
+
+    /**
+     * @param share would be attached to every handle performed, it must be
+     *              thread-safe, e.g. Share<> with enable_multithreaded_share() called,
+     *              and outlive this client.
+     *              <br>Pass nullptr to disable sharing.
+     *
+     * Must be called before start().
+     */
+    void set_share(Share_base *share) noexcept;
+    /**
+     * Same as Multi_t::set_multiplexing.
+     *
+     * Must be called before start().
+     */
+    void set_multiplexing(long max_concurrent_stream) noexcept;
+
+    /**
+     * Create Multi_t and start the background thread.
+     */
+    auto start() noexcept -> Ret_except<void, std::system_error, curl::Exception>;
+
+    /**
+     * Thread-safe.
+     *
+     * @pre start() is called and stop() is not.
+     * @param easy must be fully configured and not used by other threads until
+     *             perform() returns.
+     *             <br>Its private pointer is used while the transfer is in progress
+     *             and restored before perform() returns.
+     * @return same as Easy_ref_t::perform().
+     *
+     * Block until the transfer is done.
+     */
+    auto perform(Easy_ref_t &easy) noexcept -> Easy_ref_t::perform_ret_t;
+
+    /**
+     * Stop the background thread.
+     *
+     * perform() must not be called concurrently with or after this call.
+     */
+    void stop() noexcept;
+
+    /**
+     * Calls stop().
+     */
+    ~Blocking_client();
+};
+} /* namespace curl */
+
+#endif
@@ -0,0 +1,113 @@
+#include "curl_completion_queue.hpp"
+
+#include <cerrno>
+#include <cstdint>
+
+#include <poll.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+
+namespace curl {
+auto Completion_queue::init(std::size_t capacity) noexcept -> 
+    Ret_except<void, std::bad_alloc, std::system_error>
+{
+    bool oom = false;
+    completions.init(capacity).Catch([&](std::bad_alloc) noexcept { oom = true; });
+    if (!oom)
+        returns.init(capacity).Catch([&](std::bad_alloc) noexcept { oom = true; });
+    if (oom)
+        return {std::bad_alloc{}};
+
+    eventfd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (eventfd == -1)
+        return {std::system_error{errno, std::generic_category(),
+                                  "In curl::Completion_queue::init: eventfd failed"}};
+
+    return {};
+}
+
+void Completion_queue::notify() noexcept
+{
+    std::uint64_t value = 1;
+    write(eventfd, &value, sizeof(value));
+}
+
+auto Completion_queue::collect(Multi_t &multi) noexcept -> std::size_t
+{
+    Finished_easy batch[batch_size];
+    std::size_t total = 0;
+
+    for (std::size_t room; (room = completions.get_capacity() - completions.size()); ) {
+        auto cnt = multi.get_finished_easies(batch, room < batch_size ? room : batch_size);
+        if (cnt == 0)
+            break;
+
+        for (std::size_t i = 0; i != cnt; ++i)
+            multi.remove_easy(batch[i].easy_ref);
+
+        // Only this thread pushes, so there's room for all of them.
+        completions.push(batch, cnt);
+        total += cnt;
+    }
+
+    if (total)
+        notify();
+
+    return total;
+}
+
+int Completion_queue::get_eventfd() const noexcept
+{
+    return eventfd;
+}
+auto Completion_queue::wait(int timeout) noexcept -> Ret_except<bool, std::system_error>
+{
+    struct pollfd pfd = {eventfd, POLLIN, 0};
+
+    int ret;
+    while ((ret = poll(&pfd, 1, timeout)) == -1 && errno == EINTR);
+    if (ret == -1)
+        return {std::system_error{errno, std::generic_category(),
+                                  "In curl::Completion_queue::wait: poll failed"}};
+    if (ret == 0)
+        return {false};
+
+    std::uint64_t value;
+    read(eventfd, &value, sizeof(value));
+
+    return {true};
+}
+
+auto Completion_queue::pop(Finished_easy *finished, std::size_t n) noexcept -> std::size_t
+{
+    return completions.pop(finished, n);
+}
+
+bool Completion_queue::give_back(Easy_t &easy) noexcept
+{
+    char *curl_easy = easy.get();
+    if (!returns.push(curl_easy))
+        return false;
+
+    easy.release();
+    return true;
+}
+
+Completion_queue::~Completion_queue()
+{
+    if (completions.get_capacity()) {
+        Finished_easy batch[batch_size];
+        for (std::size_t cnt; (cnt = completions.pop(batch, batch_size)); )
+            for (std::size_t i = 0; i != cnt; ++i)
+                Easy_t easy{batch[i].easy_ref.curl_easy};
+    }
+
+    if (returns.get_capacity())
+        recycle([](Easy_ref_t &easy_ref) noexcept {
+            Easy_t easy{easy_ref.curl_easy};
+        });
+
+    if (eventfd != -1)
+        close(eventfd);
+}
+} /* namespace curl */
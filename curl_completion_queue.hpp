@@ -0,0 +1,136 @@
+#ifndef  __curl_cpp_curl_completion_queue_HPP__
+# define __curl_cpp_curl_completion_queue_HPP__
+
+# include "curl_easy.hpp"
+# include "curl_multi.hpp"
+# include "utils/spsc_ring.hpp"
+
+# include <cstddef>
+# include <new>
+# include <system_error>
+
+namespace curl {
+/**
+ * @example curl_completion_queue.cc
+ *
+ * Completion_queue decouples the thread running the event loop of a Multi_t
+ * (the network thread) from the thread processing results (the consumer),
+ * modeled after the completion queue of io_uring.
+ *
+ *  - The network thread calls Multi_t::perform() or Multi_t::multi_socket_action()
+ *    without callback, then collect(), which removes finished transfers from Multi_t
+ *    and pushes them onto a bounded completion ring;
+ *  - The consumer pop() them, process the results and give_back() the handles
+ *    via a return ring;
+ *  - The network thread recycle() returned handles, e.g. to reuse them for new requests.
+ *
+ * Both rings are lock-free single-producer single-consumer, so slow result processing
+ * never stalls other transfers on the event loop.
+ * <br>When the completion ring is full, finished transfers are left in Multi_t
+ * until the next collect().
+ *
+ * The consumer is notified via an eventfd, see wait() and get_eventfd().
+ * <br>The network thread is not notified of handles given back, it should call
+ * recycle() in every iteration of its event loop.
+ */
+class Completion_queue {
+public:
+    using Finished_easy = Multi_t::Finished_easy;
+
+protected:
+    /**
+     * Max number of records moved at once.
+     */
+    static constexpr const std::size_t batch_size = 64;
+
+    utils::spsc_ring<Finished_easy> completions;
+    utils::spsc_ring<char*> returns;
+
+    int eventfd = -1;
+
+    void notify() noexcept;
+
+public:
+    Completion_queue() = default;
+
+    Completion_queue(const Completion_queue&) = delete;
+    Completion_queue(Completion_queue&&) = delete;
+
+    Completion_queue& operator = (const Completion_queue&) = delete;
+    Completion_queue& operator = (Completion_queue&&) = delete;
+
+    /**
+     * @param capacity of each ring, would be rounded up to power of 2, must be > 0.
+     */
+    auto init(std::size_t capacity) noexcept -> Ret_except<void, std::bad_alloc, std::system_error>;
+
+    /* Interface for the network thread */
+
+    /**
+     * Remove finished transfers from multi and push them onto the completion ring.
+     *
+     * @return number of transfers pushed.
+     */
+    auto collect(Multi_t &multi) noexcept -> std::size_t;
+
+    /**
+     * @param f called with (Easy_ref_t&) for each handle given back, in the order
+     *          they are given back. It takes over the ownership of the handle.
+     * @return number of handles recycled.
+     */
+    template <class F>
+    auto recycle(F &&f) noexcept -> std::size_t
+    {
+        char *batch[batch_size];
+        std::size_t total = 0;
+
+        for (std::size_t cnt; (cnt = returns.pop(batch, batch_size)); total += cnt)
+            for (std::size_t i = 0; i != cnt; ++i) {
+                Easy_ref_t easy_ref{batch[i]};
+                f(easy_ref);
+            }
+
+        return total;
+    }
+
+    /* Interface for the consumer */
+
+    /**
+     * @return the eventfd, which becomes readable when transfers are collected.
+     *         <br>It should be polled for POLLIN/EPOLLIN level-triggered and
+     *         read to clear before calling pop() until it returns 0.
+     */
+    int get_eventfd() const noexcept;
+    /**
+     * Wait until transfers are collected and clear the eventfd.
+     *
+     * @param timeout in ms, -1 for infinite.
+     * @return false on timeout.
+     *
+     * After it returns true, pop() should be called until it returns 0,
+     * since one notification can cover multiple collect().
+     */
+    auto wait(int timeout) noexcept -> Ret_except<bool, std::system_error>;
+
+    /**
+     * @param finished array of at least n records.
+     * @return number of records popped.
+     *
+     * The handles are owned by the consumer, which should either give_back() or free them.
+     */
+    auto pop(Finished_easy *finished, std::size_t n) noexcept -> std::size_t;
+
+    /**
+     * @param easy released on success.
+     * @return false if the return ring is full.
+     */
+    bool give_back(Easy_t &easy) noexcept;
+
+    /**
+     * Free handles left in both rings and close the eventfd.
+     */
+    ~Completion_queue();
+};
+} /* namespace curl */
+
+#endif
@@ -0,0 +1,259 @@
+#ifndef  __curl_cpp_curl_coroutine_HPP__
+# define __curl_cpp_curl_coroutine_HPP__
+
+# if __cplusplus >= 202002L && __has_include(<coroutine>)
+#  define CURL_CPP_HAS_COROUTINE 1
+
+#  include "curl_easy.hpp"
+#  include "curl_multi.hpp"
+
+#  include <cstddef>
+#  include <cstdlib>
+#  include <coroutine>
+#  include <exception>
+#  include <new>
+#  include <utility>
+
+namespace curl {
+/**
+ * @example curl_coroutine.cc
+ *
+ * Requires C++20, everything in this header is only defined
+ * (and CURL_CPP_HAS_COROUTINE is only defined) if compiled with it.
+ *
+ * Coroutine support on top of Multi_t:
+ *
+ *     curl::Task download(curl::Multi_t &multi, curl::Easy_ref_t easy_ref)
+ *     {
+ *         auto ret = co_await curl::fetch(multi, easy_ref);
+ *         ...
+ *     }
+ *
+ * The coroutine is resumed directly from the perform_callback of the event loop
+ * driving multi, which must be curl::resume_fetch, e.g.
+ *  - multi.perform(curl::resume_fetch, nullptr) with Multi_t::poll;
+ *  - epoll.perform(curl::resume_fetch, nullptr) with Multi_epoll_t.
+ *
+ * The state of a transfer lives in the frame of the coroutine, which is allocated from
+ * a per-thread pool (Frame_pool), so no allocation is needed per request in steady state.
+ */
+
+/**
+ * Per-thread cache of coroutine frames, size-classed by multiple of granularity.
+ *
+ * Frames larger than max_size are allocated by malloc directly.
+ * <br>Frames freed on a thread other than the one allocated them are
+ * cached by that thread.
+ */
+class Frame_pool {
+public:
+    static constexpr const std::size_t granularity = 64;
+    static constexpr const std::size_t class_cnt = 16;
+    static constexpr const std::size_t max_size = granularity * class_cnt;
+    /**
+     * Max number of free frames cached per size class.
+     */
+    static constexpr const std::size_t max_cached = 64;
+
+protected:
+    struct Block {
+        Block *next;
+    };
+
+    Block *free_lists[class_cnt] = {};
+    std::size_t cached[class_cnt] = {};
+
+    static constexpr auto get_class(std::size_t size) noexcept -> std::size_t
+    {
+        return (size + granularity - 1) / granularity - 1;
+    }
+
+public:
+    Frame_pool() = default;
+
+    Frame_pool(const Frame_pool&) = delete;
+    Frame_pool& operator = (const Frame_pool&) = delete;
+
+    static auto get() noexcept -> Frame_pool&
+    {
+        thread_local Frame_pool pool;
+        return pool;
+    }
+
+    /**
+     * @return nullptr if out of memory.
+     */
+    void* allocate(std::size_t size) noexcept
+    {
+        if (size > max_size)
+            return std::malloc(size);
+
+        auto i = get_class(size);
+        if (Block *block = free_lists[i]) {
+            free_lists[i] = block->next;
+            --cached[i];
+            return block;
+        }
+        return std::malloc((i + 1) * granularity);
+    }
+
+    /**
+     * @param size must be the same as the one passed to allocate().
+     */
+    void deallocate(void *p, std::size_t size) noexcept
+    {
+        if (size > max_size) {
+            std::free(p);
+            return;
+        }
+
+        auto i = get_class(size);
+        if (cached[i] == max_cached) {
+            std::free(p);
+            return;
+        }
+
+        free_lists[i] = new (p) Block{free_lists[i]};
+        ++cached[i];
+    }
+
+    ~Frame_pool()
+    {
+        for (Block *block: free_lists)
+            while (block) {
+                Block *next = block->next;
+                std::free(block);
+                block = next;
+            }
+    }
+};
+
+/**
+ * Return type of coroutines using fetch().
+ *
+ * The coroutine starts running immediately and is detached: its frame is
+ * destroyed once it returns.
+ */
+class Task {
+    bool valid;
+
+    Task(bool valid_arg) noexcept:
+        valid{valid_arg}
+    {}
+
+public:
+    struct promise_type {
+        static void* operator new(std::size_t size) noexcept
+        {
+            return Frame_pool::get().allocate(size);
+        }
+        static void operator delete(void *p, std::size_t size) noexcept
+        {
+            Frame_pool::get().deallocate(p, size);
+        }
+
+        static auto get_return_object_on_allocation_failure() noexcept -> Task
+        {
+            return {false};
+        }
+        auto get_return_object() noexcept -> Task
+        {
+            return {true};
+        }
+
+        auto initial_suspend() noexcept -> std::suspend_never { return {}; }
+        auto final_suspend() noexcept -> std::suspend_never { return {}; }
+
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept
+        {
+            std::terminate();
+        }
+    };
+
+    /**
+     * @return false if failed to allocate the coroutine frame, in which case
+     *         the coroutine is not run.
+     */
+    operator bool () const noexcept
+    {
+        return valid;
+    }
+};
+
+/**
+ * Awaitable returned by fetch().
+ */
+class Fetch_awaiter {
+    friend struct Fetch_resumer;
+
+    Multi_t &multi;
+    Easy_ref_t easy_ref;
+
+    void *saved_private = nullptr;
+    std::coroutine_handle<> handle;
+    Easy_ref_t::perform_ret_t result{Easy_ref_t::code::ok};
+
+public:
+    Fetch_awaiter(Multi_t &multi_arg, Easy_ref_t easy_ref_arg) noexcept:
+        multi{multi_arg},
+        easy_ref{easy_ref_arg}
+    {}
+
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+    void await_suspend(std::coroutine_handle<> handle_arg) noexcept
+    {
+        handle = handle_arg;
+
+        saved_private = easy_ref.get_private();
+        easy_ref.set_private(this);
+
+        multi.add_easy(easy_ref);
+    }
+    auto await_resume() noexcept -> Easy_ref_t::perform_ret_t
+    {
+        return std::move(result);
+    }
+};
+
+/**
+ * perform_callback that resumes coroutines awaiting fetch().
+ *
+ * Every handle in the Multi_t must be added via fetch().
+ */
+struct Fetch_resumer {
+    template <class T>
+    void operator () (Easy_ref_t &easy_ref, Easy_ref_t::perform_ret_t ret, Multi_t &multi, T&&) const noexcept
+    {
+        multi.remove_easy(easy_ref);
+
+        auto *awaiter = static_cast<Fetch_awaiter*>(easy_ref.get_private());
+        easy_ref.set_private(awaiter->saved_private);
+
+        awaiter->result = std::move(ret);
+        awaiter->handle.resume();
+    }
+};
+
+inline constexpr const Fetch_resumer resume_fetch{};
+
+/**
+ * @pre curl_t::has_private_ptr_support()
+ * @param easy_ref must be fully configured and not added to any Multi_t.
+ *                 <br>Its private pointer is used by fetch() while the transfer
+ *                 is in progress and restored before the coroutine is resumed.
+ * @return awaitable that adds easy_ref to multi on co_await and resumes the coroutine
+ *         with Easy_ref_t::perform_ret_t once the transfer is done, at which point
+ *         easy_ref has already been removed from multi.
+ */
+inline auto fetch(Multi_t &multi, Easy_ref_t easy_ref) noexcept -> Fetch_awaiter
+{
+    return {multi, easy_ref};
+}
+} /* namespace curl */
+
+# endif
+#endif
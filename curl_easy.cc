@@ -17,12 +17,9 @@ void curl_t::Easy_deleter::operator () (void *p) const noexcept
     if (p)
         curl_easy_cleanup(p);
 }
-auto curl_t::create_easy(std::size_t buffer_size) noexcept -> Easy_t
+static void setup_easy(CURL *curl, FILE *stderr_stream, std::size_t buffer_size, 
+                       bool disable_signal_handling_v) noexcept
 {
-    CURL *curl = curl_easy_init();
-    if (!curl)
-        return {nullptr};
-
     if (stderr_stream) {
         curl_easy_setopt(curl, CURLOPT_STDERR, stderr_stream);
         curl_easy_setopt(curl, CURLOPT_VERBOSE, 1L);
@@ -36,6 +33,14 @@ auto curl_t::create_easy(std::size_t buffer_size) noexcept -> Easy_t
 
     if (disable_signal_handling_v)
         curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1);
+}
+auto curl_t::create_easy(std::size_t buffer_size) noexcept -> Easy_t
+{
+    CURL *curl = curl_easy_init();
+    if (!curl)
+        return {nullptr};
+
+    setup_easy(curl, stderr_stream, buffer_size, disable_signal_handling_v);
 
     using Easy_ptr = std::unique_ptr<char, Easy_deleter>;
     return {Easy_ptr{static_cast<char*>(curl)}};
@@ -60,6 +65,11 @@ auto curl_t::dup_easy(const Easy_t &e, std::size_t buffer_size) noexcept -> Easy
     using Easy_ptr = std::unique_ptr<char, Easy_deleter>;
     return {Easy_ptr{static_cast<char*>(curl)}};
 }
+void curl_t::reset_easy(const Easy_t &e, std::size_t buffer_size) noexcept
+{
+    curl_easy_reset(e.get());
+    setup_easy(e.get(), stderr_stream, buffer_size, disable_signal_handling_v);
+}
 
 void Easy_ref_t::set_verbose(FILE *stderr_stream_arg) noexcept
 {
@@ -94,6 +104,19 @@ void Easy_ref_t::set_writeback(writeback_t writeback, void *userp) noexcept
     curl_easy_setopt(curl_easy, CURLOPT_WRITEDATA, userp);
 }
 
+void Easy_ref_t::set_header_writeback(writeback_t headerback, void *userp) noexcept
+{
+    curl_easy_setopt(curl_easy, CURLOPT_HEADERFUNCTION, headerback);
+    curl_easy_setopt(curl_easy, CURLOPT_HEADERDATA, userp);
+}
+
+void Easy_ref_t::set_xferinfo(xferinfo_t xferinfo, void *userp) noexcept
+{
+    curl_easy_setopt(curl_easy, CURLOPT_XFERINFOFUNCTION, xferinfo);
+    curl_easy_setopt(curl_easy, CURLOPT_XFERINFODATA, userp);
+    curl_easy_setopt(curl_easy, CURLOPT_NOPROGRESS, xferinfo ? 0L : 1L);
+}
+
 void Easy_ref_t::set_url(const Url_ref_t &url) noexcept
 {
     curl_easy_setopt(curl_easy, CURLOPT_CURLU, url.url);
@@ -230,7 +253,19 @@ void Easy_ref_t::set_timeout(unsigned long timeout) noexcept
 
 void Easy_ref_t::set_http_header(const utils::slist &l, header_option option) noexcept
 {
-    curl_easy_setopt(curl_easy, CURLOPT_HTTPHEADER, static_cast<struct curl_slist*>(l.get_underlying_ptr()));
+    set_http_header_impl(l.get_underlying_ptr(), option);
+}
+void Easy_ref_t::set_http_header(const utils::arena_slist &l, header_option option) noexcept
+{
+    set_http_header_impl(l.get_underlying_ptr(), option);
+}
+void Easy_ref_t::set_http_header(const utils::header_set &s, header_option option) noexcept
+{
+    set_http_header_impl(s.get_underlying_ptr(), option);
+}
+void Easy_ref_t::set_http_header_impl(void *l, header_option option) noexcept
+{
+    curl_easy_setopt(curl_easy, CURLOPT_HTTPHEADER, static_cast<struct curl_slist*>(l));
     if (option != header_option::unspecified) {
         long value;
         if (option == header_option::separate)
@@ -264,6 +299,41 @@ void Easy_ref_t::request_post(readback_t readback, void *userp, std::size_t len)
     curl_easy_setopt(curl_easy, CURLOPT_READDATA, userp);
 }
 
+static std::size_t file_readback(char *buffer, std::size_t size, std::size_t nitems, void *ptr) noexcept
+{
+    auto ret = static_cast<utils::file_source*>(ptr)->read(buffer, size * nitems);
+    if (ret == static_cast<std::size_t>(-1))
+        return CURL_READFUNC_ABORT;
+    return ret;
+}
+static int file_seekback(void *ptr, curl_off_t offset, int origin) noexcept
+{
+    if (origin != SEEK_SET || offset < 0)
+        return CURL_SEEKFUNC_CANTSEEK;
+    return static_cast<utils::file_source*>(ptr)->seek(offset) ? CURL_SEEKFUNC_OK : CURL_SEEKFUNC_CANTSEEK;
+}
+static void set_file_readback(char *curl_easy, utils::file_source &source) noexcept
+{
+    curl_easy_setopt(curl_easy, CURLOPT_READFUNCTION, file_readback);
+    curl_easy_setopt(curl_easy, CURLOPT_READDATA, &source);
+
+    curl_easy_setopt(curl_easy, CURLOPT_SEEKFUNCTION, file_seekback);
+    curl_easy_setopt(curl_easy, CURLOPT_SEEKDATA, &source);
+}
+void Easy_ref_t::request_post_file(utils::file_source &source) noexcept
+{
+    // Undo request_put_file, otherwise older libcurl keeps doing PUT
+    curl_easy_setopt(curl_easy, CURLOPT_UPLOAD, 0L);
+    request_post(nullptr, source.size());
+    set_file_readback(curl_easy, source);
+}
+void Easy_ref_t::request_put_file(utils::file_source &source) noexcept
+{
+    curl_easy_setopt(curl_easy, CURLOPT_UPLOAD, 1L);
+    curl_easy_setopt(curl_easy, CURLOPT_INFILESIZE_LARGE, static_cast<curl_off_t>(source.size()));
+    set_file_readback(curl_easy, source);
+}
+
 auto Easy_ref_t::perform() noexcept -> perform_ret_t
 {
     return check_perform(curl_easy_perform(curl_easy), "curl::Easy_ref_t::perform");
@@ -344,6 +414,48 @@ std::size_t Easy_ref_t::getinfo_transfer_time() const noexcept
     return total;
 }
 
+auto Easy_ref_t::getinfo_transfer_report(const curl_t &curl) const noexcept -> Transfer_report
+{
+    struct Time_info {
+        std::size_t Transfer_report::*field;
+        CURLINFO info_us;
+        CURLINFO info_seconds;
+    };
+    static constexpr const Time_info time_infos[] = {
+        {&Transfer_report::namelookup_time,    CURLINFO_NAMELOOKUP_TIME_T,    CURLINFO_NAMELOOKUP_TIME},
+        {&Transfer_report::connect_time,       CURLINFO_CONNECT_TIME_T,       CURLINFO_CONNECT_TIME},
+        {&Transfer_report::appconnect_time,    CURLINFO_APPCONNECT_TIME_T,    CURLINFO_APPCONNECT_TIME},
+        {&Transfer_report::pretransfer_time,   CURLINFO_PRETRANSFER_TIME_T,   CURLINFO_PRETRANSFER_TIME},
+        {&Transfer_report::starttransfer_time, CURLINFO_STARTTRANSFER_TIME_T, CURLINFO_STARTTRANSFER_TIME},
+        {&Transfer_report::redirect_time,      CURLINFO_REDIRECT_TIME_T,      CURLINFO_REDIRECT_TIME},
+        {&Transfer_report::total_time,         CURLINFO_TOTAL_TIME_T,         CURLINFO_TOTAL_TIME},
+    };
+
+    Transfer_report report;
+
+    const bool has_us = curl.has_microsecond_timing_support();
+
+    for (const auto &time_info: time_infos) {
+        if (has_us) {
+            curl_off_t us = 0;
+            curl_easy_getinfo(curl_easy, time_info.info_us, &us);
+            report.*time_info.field = us;
+        } else {
+            double seconds = 0;
+            curl_easy_getinfo(curl_easy, time_info.info_seconds, &seconds);
+            report.*time_info.field = static_cast<std::size_t>(seconds * 1000000);
+        }
+    }
+
+    report.num_connects = 0;
+    curl_easy_getinfo(curl_easy, CURLINFO_NUM_CONNECTS, &report.num_connects);
+
+    report.redirect_count = 0;
+    curl_easy_getinfo(curl_easy, CURLINFO_REDIRECT_COUNT, &report.redirect_count);
+
+    return report;
+}
+
 auto Easy_ref_t::getinfo_redirect_url() const noexcept -> const char*
 {
     char *url = nullptr;
@@ -374,6 +486,55 @@ auto Easy_ref_t::get_active_socket() const noexcept -> curl_socket_t
     return socketfd;
 }
 
+void Easy_ref_t::set_ring_writeback(utils::ring_buffer &ring) noexcept
+{
+    set_writeback([](char *buffer, std::size_t _, std::size_t size, void *ptr) -> std::size_t {
+        auto &ring = *static_cast<utils::ring_buffer*>(ptr);
+
+        if (size > ring.get_capacity())
+            return 0;
+
+        if (ring.write(buffer, size))
+            return size;
+
+        ring.set_paused(true);
+        return CURL_WRITEFUNC_PAUSE;
+    }, &ring);
+}
+auto Easy_ref_t::resume_ring_writeback(utils::ring_buffer &ring) noexcept -> 
+    Ret_except<code, std::bad_alloc, Exception>
+{
+    if (!ring.is_paused())
+        return {code::ok};
+
+    ring.set_paused(false);
+    return set_pause(PauseOptions::cont);
+}
+
+void Easy_ref_t::set_file_writeback(utils::file_sink &sink) noexcept
+{
+    curl_easy_setopt(curl_easy, CURLOPT_RESUME_FROM_LARGE, static_cast<curl_off_t>(sink.get_resume_offset()));
+
+    set_header_writeback([](char *buffer, std::size_t _, std::size_t size, void *ptr) {
+        auto &sink = *static_cast<utils::file_sink*>(ptr);
+
+        // Content-Length of a resumed transfer is the length of remaining part.
+        std::size_t content_length;
+        if (utils::is_status_line(buffer, size))
+            // A new response starts, e.g. after a redirect
+            sink.set_expected_size(0);
+        else if (utils::parse_content_length(buffer, size, content_length))
+            // Only the body of the final response is passed to sink.write().
+            sink.set_expected_size(sink.get_resume_offset() + content_length);
+
+        return size;
+    }, &sink);
+
+    set_writeback([](char *buffer, std::size_t _, std::size_t size, void *ptr) {
+        return static_cast<utils::file_sink*>(ptr)->write(buffer, size) ? size : 0;
+    }, &sink);
+}
+
 void Easy_ref_t::setup_establish_connection_only() noexcept
 {
     request_get();
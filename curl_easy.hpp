@@ -4,15 +4,25 @@
 # include <cstddef>
 # include <utility>
 # include <string>
+# include <string_view>
+# include <type_traits>
 
 # include "curl.hpp"
 # include "utils/curl_slist.hpp"
+# include "utils/arena_slist.hpp"
+# include "utils/header_set.hpp"
+# include "utils/ring_buffer.hpp"
+# include "utils/rope.hpp"
+# include "utils/http_header.hpp"
+# include "utils/file_source.hpp"
+# include "utils/file_sink.hpp"
 
 # include <curl/curl.h>
 
 namespace curl {
 /**
  * @example curl_easy_get.cc
+ * @example curl_transfer_report.cc
  *
  * Why make Easy_ref_t RAII-less?
  *
@@ -148,6 +158,53 @@ public:
      * By default, writeback == std::fwrite, userp == stdout
      */
     void set_writeback(writeback_t writeback, void *userp) noexcept;
+    /**
+     * @param f must be kept around until the transfer is done, and be callable as either
+     *          f(std::string_view data) or f(char *buffer, std::size_t size).
+     *          <br>It can return std::size_t, which has the same meaning as return value
+     *          of writeback_t, or void if all data is always consumed.
+     *
+     * A trampoline is generated for F, so the body of f can be inlined into it.
+     */
+    template <class F, class = std::enable_if_t<std::is_invocable_v<F&, std::string_view> ||
+                                                std::is_invocable_v<F&, char*, std::size_t>>>
+    void set_writeback(F &f) noexcept
+    {
+        set_writeback([](char *buffer, std::size_t _, std::size_t size, void *ptr) -> std::size_t {
+            return invoke_writeback(*static_cast<F*>(ptr), buffer, size);
+        }, &f);
+    }
+
+    /**
+     * @param headerback same as writeback_t, except that it is called once for each header line,
+     *                   including the status line and the empty line that ends headers.
+     *                   <br>The line is CRLF-terminated and not null-terminated.
+     *                   <br>Pass nullptr to disable it (default).
+     *
+     * Headers of every response received are passed to headerback, including 
+     * responses of redirection and "100 Continue".
+     */
+    void set_header_writeback(writeback_t headerback, void *userp) noexcept;
+
+    /**
+     * @param dltotal number of bytes expected to be downloaded, 0 if unknown.
+     * @param dlnow number of bytes downloaded so far.
+     * @param ultotal number of bytes expected to be uploaded, 0 if unknown.
+     * @param ulnow number of bytes uploaded so far.
+     * @return 0 to continue, non-zero to abort the transfer with code::aborted_by_callback.
+     *
+     * It is called roughly once per second while idle, and frequently during
+     * data transfer.
+     * <br>Use curl::Progress_sampler if you only need it to be called every now and then.
+     */
+    using xferinfo_t = int (*)(void *userp, curl_off_t dltotal, curl_off_t dlnow, 
+                                            curl_off_t ultotal, curl_off_t ulnow);
+
+    /**
+     * @pre curl_t::has_xferinfo_support()
+     * @param xferinfo pass nullptr to disable progress meter (default).
+     */
+    void set_xferinfo(xferinfo_t xferinfo, void *userp) noexcept;
 
     /**
      * @pre curl_t::has_CURLU()
@@ -495,6 +552,23 @@ public:
      * the CURLOPT_UNRESTRICTED_AUTH option.
      */
     void set_http_header(const utils::slist &l, header_option option = header_option::unspecified) noexcept;
+    /**
+     * Same as set_http_header(const utils::slist&, header_option), except that
+     * it takes utils::arena_slist or utils::header_overlay.
+     *
+     * @param l will not be copied, thus it is required to be kept around and 
+     *          not modified until another set_http_header is issued or 
+     *          this Easy_t is destroyed.
+     */
+    void set_http_header(const utils::arena_slist &l, header_option option = header_option::unspecified) noexcept;
+    /**
+     * Same as set_http_header(const utils::slist&, header_option), except that
+     * it takes utils::header_set.
+     *
+     * @param s will not be copied, thus it (or a copy of it) is required to be kept around
+     *          until another set_http_header is issued or this Easy_t is destroyed.
+     */
+    void set_http_header(const utils::header_set &s, header_option option = header_option::unspecified) noexcept;
 
     /**
      * @param enable if true, then it would not request body data to be transfered;
@@ -543,6 +617,49 @@ public:
      * @param len optional. Set to -1 means length of data is not known ahead of time.
      */
     void request_post(readback_t readback, void *userp, std::size_t len = -1) noexcept;
+    /**
+     * @pre url is set to use http(s) && curl_t::has_protocol("http")
+     * @param f must be kept around until the transfer is done, and be callable as 
+     *          f(char *buffer, std::size_t size) returning std::size_t, which has the same 
+     *          meaning as return value of readback_t.
+     * @param len optional. Set to -1 means length of data is not known ahead of time.
+     *
+     * A trampoline is generated for F, so the body of f can be inlined into it.
+     */
+    template <class F, class = std::enable_if_t<std::is_invocable_r_v<std::size_t, F&, char*, std::size_t>>>
+    void request_post(F &f, std::size_t len = -1) noexcept
+    {
+        request_post([](char *buffer, std::size_t size, std::size_t nitems, void *ptr) -> std::size_t {
+            return (*static_cast<F*>(ptr))(buffer, size * nitems);
+        }, &f, len);
+    }
+
+    /**
+     * @pre url is set to use http(s) && curl_t::has_protocol("http")
+     * @param source must be kept around until the transfer finishes.
+     *               <br>If source.size() == -1, then chunked transfer encoding is used.
+     *
+     * Upload source as the request body of POST.
+     *
+     * libcurl's read callback is served straight from the mapping of source if
+     * source.is_mapped(), and the transfer can be rewinded (e.g. on redirection) 
+     * if source is seekable.
+     *
+     * It is safe to call after request_put_file on the same handle, as the upload
+     * mode set by the latter is cleared.
+     */
+    void request_post_file(utils::file_source &source) noexcept;
+    /**
+     * @pre curl_t::has_protocol(protocol you use in url)
+     * @param source same as request_post_file.
+     *
+     * Upload source to url, which is PUT for http(s).
+     *
+     * The handle stays in upload mode until request_get(), request_post_file()
+     * or curl_t::reset_easy() is called, so call one of them before reusing
+     * it for other kind of requests.
+     */
+    void request_put_file(utils::file_source &source) noexcept;
 
     /**
      * @pre curl_t::has_protocol(protocol you use in url)
@@ -562,6 +679,7 @@ public:
         aborted_by_callback, // If readback return CURL_READFUNC_ABORT.
         too_many_redirects, 
         ssl_pinned_pubkey_mismatch,
+        range_error, // Server doesn't support resuming/range request, or the resume offset is invalid.
     };
     using perform_ret_t = Ret_except<code, std::bad_alloc, std::invalid_argument, std::length_error, 
                                      Exception, Recursive_api_call_Exception, NotBuiltIn_error, 
@@ -671,6 +789,45 @@ public:
      */
     std::size_t getinfo_transfer_time() const noexcept;
 
+    /**
+     * Timing and connection statistics of a transfer.
+     *
+     * All times are in microseconds, measured from the start of the transfer
+     * (see getinfo_transfer_time for what each phase covers).
+     * <br>If redirections are followed, they are the sum of all transfers.
+     */
+    struct Transfer_report {
+        std::size_t namelookup_time;
+        std::size_t connect_time;
+        /**
+         * 0 if no SSL/SSH handshake is done.
+         */
+        std::size_t appconnect_time;
+        std::size_t pretransfer_time;
+        std::size_t starttransfer_time;
+        /**
+         * Time spent on all redirection steps before the final transfer.
+         */
+        std::size_t redirect_time;
+        std::size_t total_time;
+
+        /**
+         * Number of new connections created to complete the transfer.
+         */
+        long num_connects;
+        long redirect_count;
+    };
+    /**
+     * @return Transfer_report of the last transfer.
+     *
+     * All fields are retrieved in one call, thus it is cheap enough to be called
+     * for every completed transfer, e.g. in perform_callback of Multi_t.
+     *
+     * @param curl used to check curl_t::has_microsecond_timing_support(), if false,
+     *             times are converted from the less precise ones in seconds.
+     */
+    auto getinfo_transfer_report(const curl_t &curl) const noexcept -> Transfer_report;
+
     /**
      * @pre curl_t::has_redirect_url_support() && 
      *      url is set to use http(s) && curl_t::has_protocol("http")
@@ -757,6 +914,137 @@ public:
         }, &arg);
     }
 
+    /**
+     * Argument of set_presized_readall_writeback().
+     */
+    template <class String>
+    struct Presized_readall {
+        static constexpr const std::size_t default_max_reserve = 16 * 1024 * 1024;
+
+        String response;
+        /**
+         * Data that doesn't fit in the space reserved in response.
+         */
+        utils::rope rest;
+
+        /**
+         * Max number of bytes reserve()-ed according to "Content-Length", to
+         * avoid allocating whatever size a server claims.
+         */
+        std::size_t max_reserve = default_max_reserve;
+
+        /**
+         * "Content-Length" of the response being received, 0 if not known.
+         * <br>Used by set_presized_readall_writeback().
+         */
+        std::size_t content_length = 0;
+    };
+
+    /**
+     * set_presized_readall_writeback() can be used for get or post.
+     *
+     * This function will set both header writeback and writeback.
+     *
+     * arg.response is reserve()-ed on the first chunk of response body according to
+     * "Content-Length" of the final response (redirects and 1xx responses are ignored),
+     * clamped to arg.max_reserve and response.max_size(),
+     * so that the response body is appended to it without reallocation.
+     *
+     * If the server doesn't send "Content-Length" or sends more data than that
+     * (e.g. the response is compressed), the rest of the response is appended to 
+     * arg.rest, which never moves data already stored.
+     * <br>Call arg.rest.move_to(arg.response) after the transfer is done to get
+     * the complete response.
+     *
+     * String must support size(), capacity(), max_size(), reserve() and append(first, last).
+     */
+    template <class String>
+    void set_presized_readall_writeback(Presized_readall<String> &arg) noexcept
+    {
+        set_header_writeback([](char *buffer, std::size_t _, std::size_t size, void *ptr) {
+            auto &args = *static_cast<Presized_readall<String>*>(ptr);
+
+            std::size_t content_length;
+            if (utils::is_status_line(buffer, size))
+                // A new response starts, e.g. after a redirect
+                args.content_length = 0;
+            else if (utils::parse_content_length(buffer, size, content_length))
+                args.content_length = content_length;
+
+            return size;
+        }, &arg);
+
+        set_writeback([](char *buffer, std::size_t _, std::size_t size, void *ptr) {
+            auto &args = *static_cast<Presized_readall<String>*>(ptr);
+            auto &response = args.response;
+            auto &rope = args.rest;
+
+            if (args.content_length) {
+                // Only the body of the final response is passed to writeback.
+                std::size_t len = std::min(args.content_length, args.max_reserve);
+                std::size_t max_len = response.max_size() - response.size();
+                response.reserve(response.size() + std::min(len, max_len));
+
+                args.content_length = 0;
+            }
+
+            if (rope.is_empty() && response.capacity() - response.size() >= size)
+                response.append(buffer, buffer + size);
+            else if (!rope.append(buffer, size))
+                return std::size_t{0};
+
+            return size;
+        }, &arg);
+    }
+
+    /**
+     * @pre curl_t::has_pause_support()
+     * @param ring must be kept around until the transfer is done.
+     *             <br>Its capacity should be at least CURL_MAX_WRITE_SIZE, otherwise
+     *             the transfer fails with code::writeback_error on a chunk larger than it.
+     *
+     * set_ring_writeback() can be used for get or post.
+     *
+     * Every chunk received is copied into ring as a whole, no reallocation is ever done.
+     *
+     * When ring doesn't have enough free space for a chunk, the transfer is paused 
+     * (the same effect as set_pause(PauseOptions::recv)) and ring.is_paused() becomes true.
+     * <br>After consuming data from ring, call resume_ring_writeback() to continue the transfer.
+     */
+    void set_ring_writeback(utils::ring_buffer &ring) noexcept;
+    /**
+     * @pre curl_t::has_pause_support()
+     * @return code::ok if ring isn't paused;
+     *         otherwise same as set_pause(PauseOptions::cont).
+     *
+     * If ring.is_paused(), unset it and unpause receiving.
+     *
+     * The writeback may be called inside this function, and the transfer can be paused
+     * again if ring still doesn't have enough free space.
+     *
+     * If you use Multi_t, see set_pause for how to continue the transfer after this call.
+     */
+    auto resume_ring_writeback(utils::ring_buffer &ring) noexcept -> Ret_except<code, std::bad_alloc, Exception>;
+
+    /**
+     * @param sink must be kept around until the transfer is done.
+     *
+     * This function will set both header writeback and writeback, and
+     * resume the transfer from sink.get_resume_offset().
+     *
+     * Disk space of the file is preallocated according to "Content-Length" of the
+     * final response (redirects and 1xx responses are ignored) once its body arrives.
+     *
+     * If perform returns code::range_error, then the server doesn't support resuming
+     * the transfer: call sink.restart(), set_file_writeback(sink) and perform again to
+     * download from scratch.
+     *
+     * If perform returns code::writeback_error, sink.get_error() is set.
+     *
+     * Call sink.finish() after the transfer is done.
+     */
+    void set_file_writeback(utils::file_sink &sink) noexcept;
+
     /**
      * After this call, Easy_ref_t::perform/Multi_t::perform or multi_socket_action must be 
      * called to establish the connection.
@@ -786,6 +1074,29 @@ public:
 
 protected:
     static auto check_perform(long code, const char *fname) noexcept -> perform_ret_t;
+
+    template <class F>
+    static auto invoke_writeback(F &f, char *buffer, std::size_t size) noexcept -> std::size_t
+    {
+        if constexpr (std::is_invocable_v<F&, std::string_view>) {
+            if constexpr (std::is_void_v<std::invoke_result_t<F&, std::string_view>>) {
+                f(std::string_view{buffer, size});
+                return size;
+            } else
+                return f(std::string_view{buffer, size});
+        } else {
+            if constexpr (std::is_void_v<std::invoke_result_t<F&, char*, std::size_t>>) {
+                f(buffer, size);
+                return size;
+            } else
+                return f(buffer, size);
+        }
+    }
+
+    /**
+     * @param l struct curl_slist*
+     */
+    void set_http_header_impl(void *l, header_option option) noexcept;
 };
 } /* namespace curl */
 
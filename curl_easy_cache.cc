@@ -0,0 +1,121 @@
+#include "curl_easy_cache.hpp"
+
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+
+namespace curl {
+Easy_cache::Easy_cache(curl_t &curl_arg, std::size_t buffer_size_arg) noexcept:
+    curl{curl_arg},
+    buffer_size{buffer_size_arg},
+    share{curl.create_share()}
+{}
+
+auto Easy_cache::init(bool share_connections) noexcept -> Ret_except<void, std::bad_alloc, curl::Exception>
+{
+    if (!share)
+        return {curl::Exception{"In curl::Easy_cache::init: curl_share_init failed"}};
+
+    share.enable_multithreaded_share();
+
+    using Options = Share_base::Options;
+
+    bool oom = false;
+    auto enable_sharing = [&](Options option) noexcept {
+        if (!oom)
+            share.enable_sharing(option).Catch([&](std::bad_alloc) noexcept { oom = true; });
+    };
+
+    enable_sharing(Options::dns);
+    enable_sharing(Options::ssl_session);
+    if (share_connections)
+        enable_sharing(Options::connection_cache);
+
+    if (oom)
+        return {std::bad_alloc{}};
+
+    return {};
+}
+
+/* For Easy_cache::Local */
+Easy_cache::Local::Local(Easy_cache &cache_arg, std::size_t max_hosts_arg) noexcept:
+    cache{cache_arg},
+    max_hosts{max_hosts_arg}
+{
+    assert(max_hosts != 0);
+}
+
+void Easy_cache::Local::evict(Entry &entry) noexcept
+{
+    Easy_t easy{entry.curl_easy};
+    Easy_ref_t easy_ref{easy.get()};
+    cache.share.remove_easy(easy_ref);
+
+    std::free(entry.host);
+}
+
+auto Easy_cache::Local::get_easy(std::string_view host) noexcept -> Ret_except<Easy_ref_t, std::bad_alloc>
+{
+    ++clock;
+
+    for (std::size_t i = 0; i != cnt; ++i) {
+        auto &entry = entries[i];
+        if (std::string_view{entry.host, entry.host_len} == host) {
+            entry.last_used = clock;
+
+            Easy_t easy{entry.curl_easy};
+            cache.curl.reset_easy(easy, cache.buffer_size);
+            easy.release();
+
+            return {Easy_ref_t{entry.curl_easy}};
+        }
+    }
+
+    if (!entries) {
+        entries = static_cast<Entry*>(std::malloc(max_hosts * sizeof(Entry)));
+        if (!entries)
+            return {std::bad_alloc{}};
+    }
+
+    auto *host_copy = static_cast<char*>(std::malloc(host.size() ? host.size() : 1));
+    if (!host_copy)
+        return {std::bad_alloc{}};
+    std::memcpy(host_copy, host.data(), host.size());
+
+    auto easy = cache.curl.create_easy(cache.buffer_size);
+    if (!easy) {
+        std::free(host_copy);
+        return {std::bad_alloc{}};
+    }
+
+    Easy_ref_t easy_ref{easy.get()};
+    cache.share.add_easy(easy_ref);
+
+    Entry *entry;
+    if (cnt != max_hosts)
+        entry = &entries[cnt++];
+    else {
+        entry = entries;
+        for (std::size_t i = 1; i != cnt; ++i)
+            if (entries[i].last_used < entry->last_used)
+                entry = &entries[i];
+        evict(*entry);
+    }
+    *entry = Entry{host_copy, host.size(), easy.release(), clock};
+
+    return {easy_ref};
+}
+
+auto Easy_cache::Local::get_number_of_easy() const noexcept -> std::size_t
+{
+    return cnt;
+}
+
+Easy_cache::Local::~Local()
+{
+    for (std::size_t i = 0; i != cnt; ++i)
+        evict(entries[i]);
+    std::free(entries);
+}
+/* End of Easy_cache::Local */
+} /* namespace curl */
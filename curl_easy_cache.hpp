@@ -0,0 +1,141 @@
+#ifndef  __curl_cpp_curl_easy_cache_HPP__
+# define __curl_cpp_curl_easy_cache_HPP__
+
+# include "curl.hpp"
+# include "curl_easy.hpp"
+# include "curl_share.hpp"
+
+# include <cstddef>
+# include <cstdint>
+# include <new>
+# include <string_view>
+
+namespace curl {
+/**
+ * @example curl_easy_cache.cc
+ *
+ * Easy_cache is for code calling Easy_ref_t::perform() directly on many threads.
+ *
+ * Each thread keeps one long-lived easy handle per host via its own Easy_cache::Local,
+ * and all of them are attached to a thread-safe Share<> owned by Easy_cache
+ * with dns and ssl_session shared, so that:
+ *  - no handle is created per request;
+ *  - connections are reused by the handle of the same host;
+ *  - DNS cache and TLS sessions are reused across threads.
+ *
+ * @pre curl_t::has_ssl_session_sharing_support(), otherwise only the DNS cache is shared.
+ *
+ * Easy_cache itself is thread-safe after init() and must outlive all its Easy_cache::Local.
+ */
+class Easy_cache {
+protected:
+    curl_t &curl;
+    const std::size_t buffer_size;
+
+    Share<> share;
+
+public:
+    class Local;
+
+    /**
+     * @param buffer_size passed to curl_t::create_easy() and curl_t::reset_easy().
+     */
+    Easy_cache(curl_t &curl, std::size_t buffer_size = 0) noexcept;
+
+    Easy_cache(const Easy_cache&) = delete;
+    Easy_cache(Easy_cache&&) = delete;
+
+    Easy_cache& operator = (const Easy_cache&) = delete;
+    Easy_cache& operator = (Easy_cache&&) = delete;
+
+    /**
+     * Create the Share<> and enable sharing.
+     *
+     * @param share_connections also share the connection cache.
+     *                          <br>libcurl doesn't support using a shared connection cache
+     *                          from multiple threads concurrently, so only enable it if
+     *                          Easy_ref_t::perform() is never called on two threads at the
+     *                          same time.
+     *                          <br>Requires curl_t::has_connection_cache_sharing_support(),
+     *                          otherwise it shares nothing.
+     */
+    auto init(bool share_connections = false) noexcept -> Ret_except<void, std::bad_alloc, curl::Exception>;
+
+    /**
+     * All Easy_cache::Local must be destroyed before this cache.
+     */
+    ~Easy_cache() = default;
+};
+
+/**
+ * Per-thread handles of Easy_cache, e.g.
+ *
+ *     thread_local curl::Easy_cache::Local local{cache};
+ *
+ * At most max_hosts handles are kept, the least recently used one is freed
+ * when a handle for another host is needed.
+ *
+ * Easy_cache::Local is not thread-safe.
+ */
+class Easy_cache::Local {
+public:
+    static constexpr const std::size_t default_max_hosts = 16;
+
+protected:
+    struct Entry {
+        /**
+         * Allocated by malloc, not null-terminated.
+         */
+        char *host;
+        std::size_t host_len;
+
+        char *curl_easy;
+        std::uint64_t last_used;
+    };
+
+    Easy_cache &cache;
+    const std::size_t max_hosts;
+
+    Entry *entries = nullptr;
+    std::size_t cnt = 0;
+    std::uint64_t clock = 0;
+
+    void evict(Entry &entry) noexcept;
+
+public:
+    /**
+     * @param max_hosts must be > 0
+     */
+    Local(Easy_cache &cache, std::size_t max_hosts = default_max_hosts) noexcept;
+
+    Local(const Local&) = delete;
+    Local(Local&&) = delete;
+
+    Local& operator = (const Local&) = delete;
+    Local& operator = (Local&&) = delete;
+
+    /**
+     * @param host key of the handle, e.g. from Host_router::get_authority().
+     * @return handle for host, either cached or newly created.
+     *         <br>A cached handle is reset by curl_t::reset_easy(), thus all options
+     *         set by the previous request are discarded while its connections and
+     *         the Share<> are kept.
+     *
+     * The handle is owned by this Local, and is valid until either this Local is
+     * destroyed or it is evicted by get_easy() for another host.
+     */
+    auto get_easy(std::string_view host) noexcept -> Ret_except<Easy_ref_t, std::bad_alloc>;
+
+    /**
+     * @return number of handles cached.
+     */
+    auto get_number_of_easy() const noexcept -> std::size_t;
+
+    /**
+     * Free all handles.
+     */
+    ~Local();
+};
+} /* namespace curl */
+
+#endif
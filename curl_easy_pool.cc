@@ -0,0 +1,174 @@
+#include "curl_easy_pool.hpp"
+#include <curl/curl.h>
+
+#include <mutex>
+#include <cassert>
+
+namespace curl {
+auto Easy_pool::get_next(char *curl_easy) noexcept -> char*
+{
+    return static_cast<char*>(Easy_ref_t{curl_easy}.get_private());
+}
+void Easy_pool::set_next(char *curl_easy, char *next) noexcept
+{
+    Easy_ref_t{curl_easy}.set_private(next);
+}
+
+Easy_pool::Easy_pool(curl_t &curl_arg, std::size_t buffer_size_arg) noexcept:
+    curl{curl_arg},
+    buffer_size{buffer_size_arg}
+{}
+
+void Easy_pool::push_idle(char *first, char *last, std::size_t cnt) noexcept
+{
+    std::lock_guard guard{mutex};
+
+    set_next(last, idle_list);
+    idle_list = first;
+    idle_cnt += cnt;
+}
+auto Easy_pool::pop_idle(std::size_t &cnt) noexcept -> char*
+{
+    std::lock_guard guard{mutex};
+
+    char *first = idle_list;
+    char *last = nullptr;
+
+    std::size_t i = 0;
+    for (char *curr = idle_list; i != cnt && curr; ++i) {
+        last = curr;
+        curr = get_next(curr);
+    }
+
+    if (last) {
+        idle_list = get_next(last);
+        set_next(last, nullptr);
+    }
+
+    idle_cnt -= i;
+    cnt = i;
+
+    return i ? first : nullptr;
+}
+
+auto Easy_pool::reserve(std::size_t cnt) noexcept -> std::size_t
+{
+    std::size_t i = 0;
+    for (; i != cnt; ++i) {
+        auto easy = curl.create_easy(buffer_size);
+        if (!easy)
+            break;
+
+        char *curl_easy = easy.release();
+        push_idle(curl_easy, curl_easy, 1);
+    }
+    return i;
+}
+
+auto Easy_pool::get_easy() noexcept -> Easy_t
+{
+    std::size_t cnt = 1;
+    char *curl_easy = pop_idle(cnt);
+    if (curl_easy) {
+        set_next(curl_easy, nullptr);
+        return Easy_t{curl_easy};
+    }
+
+    return curl.create_easy(buffer_size);
+}
+void Easy_pool::recycle(Easy_t &&easy) noexcept
+{
+    assert(easy);
+
+    curl.reset_easy(easy, buffer_size);
+
+    char *curl_easy = easy.release();
+    push_idle(curl_easy, curl_easy, 1);
+}
+
+auto Easy_pool::get_number_of_idle_easy() noexcept -> std::size_t
+{
+    std::lock_guard guard{mutex};
+    return idle_cnt;
+}
+
+Easy_pool::~Easy_pool()
+{
+    for (char *curl_easy = idle_list; curl_easy; ) {
+        char *next = get_next(curl_easy);
+        curl_easy_cleanup(curl_easy);
+        curl_easy = next;
+    }
+}
+
+/* For Easy_pool::Cache */
+Easy_pool::Cache::Cache(Easy_pool &pool_arg, std::size_t batch_size_arg) noexcept:
+    pool{pool_arg},
+    batch_size{batch_size_arg}
+{
+    assert(batch_size != 0);
+}
+
+auto Easy_pool::Cache::get_easy() noexcept -> Easy_t
+{
+    if (idle_cnt == 0) {
+        std::size_t cnt = batch_size;
+        idle_list = pool.pop_idle(cnt);
+        idle_cnt = cnt;
+    }
+
+    if (idle_cnt == 0)
+        return pool.curl.create_easy(pool.buffer_size);
+
+    char *curl_easy = idle_list;
+    idle_list = get_next(curl_easy);
+    --idle_cnt;
+
+    set_next(curl_easy, nullptr);
+    return Easy_t{curl_easy};
+}
+void Easy_pool::Cache::recycle(Easy_t &&easy) noexcept
+{
+    assert(easy);
+
+    pool.curl.reset_easy(easy, pool.buffer_size);
+
+    char *curl_easy = easy.release();
+    set_next(curl_easy, idle_list);
+    idle_list = curl_easy;
+    ++idle_cnt;
+
+    if (idle_cnt > 2 * batch_size) {
+        char *first = idle_list;
+        char *last = first;
+        for (std::size_t i = 1; i != batch_size; ++i)
+            last = get_next(last);
+
+        idle_list = get_next(last);
+        idle_cnt -= batch_size;
+
+        pool.push_idle(first, last, batch_size);
+    }
+}
+
+void Easy_pool::Cache::flush() noexcept
+{
+    if (idle_cnt == 0)
+        return;
+
+    char *last = idle_list;
+    for (char *next; (next = get_next(last)); )
+        last = next;
+
+    pool.push_idle(idle_list, last, idle_cnt);
+
+    idle_list = nullptr;
+    idle_cnt = 0;
+}
+
+Easy_pool::Cache::~Cache()
+{
+    flush();
+}
+/* End of Easy_pool::Cache */
+} /* namespace curl */
@@ -0,0 +1,182 @@
+#ifndef  __curl_cpp_curl_easy_pool_HPP__
+# define __curl_cpp_curl_easy_pool_HPP__
+
+# include "curl.hpp"
+# include "curl_easy.hpp"
+# include "curl_multi.hpp"
+# include "utils/shared_mutex.hpp"
+
+# include <cstddef>
+# include <utility>
+
+namespace curl {
+/**
+ * @example curl_easy_pool.cc
+ *
+ * Easy_pool keeps easy handles around after the transfer is done,
+ * so that they can be handed out again instead of going through
+ * curl_t::create_easy() and curl_easy_cleanup for every request.
+ *
+ * Every handle recycled is reset by curl_t::reset_easy(), thus all
+ * options set by the previous user are discarded while
+ * the connection cache, DNS cache and Session ID cache of the handle are kept.
+ *
+ * Idle handles are linked together through CURLOPT_PRIVATE, so
+ * storing handles in Easy_pool/Easy_pool::Cache never allocates.
+ *
+ * @pre curl_t::has_private_ptr_support()
+ *
+ * Easy_pool itself is thread-safe.
+ * <br>To avoid contention, each thread should access it via its own Easy_pool::Cache,
+ * which moves handles from and to the Easy_pool in batch.
+ *
+ * Easy_pool must outlive all its Easy_pool::Cache.
+ */
+class Easy_pool {
+protected:
+    curl_t &curl;
+    const std::size_t buffer_size;
+
+    utils::shared_mutex mutex;
+    char *idle_list = nullptr;
+    std::size_t idle_cnt = 0;
+
+    static auto get_next(char *curl_easy) noexcept -> char*;
+    static void set_next(char *curl_easy, char *next) noexcept;
+
+    /**
+     * @param first, last must be linked via set_next, last's next is ignored.
+     */
+    void push_idle(char *first, char *last, std::size_t cnt) noexcept;
+    /**
+     * @param cnt in: max number of handles to pop;
+     *            out: number of handles actually popped.
+     * @return list of handles popped, linked via set_next and terminated by nullptr.
+     */
+    auto pop_idle(std::size_t &cnt) noexcept -> char*;
+
+public:
+    class Cache;
+
+    /**
+     * @param buffer_size passed to curl_t::create_easy() and curl_t::reset_easy().
+     */
+    Easy_pool(curl_t &curl, std::size_t buffer_size = 0) noexcept;
+
+    Easy_pool(const Easy_pool&) = delete;
+    Easy_pool(Easy_pool&&) = delete;
+
+    Easy_pool& operator = (const Easy_pool&) = delete;
+    Easy_pool& operator = (Easy_pool&&) = delete;
+
+    /**
+     * Create cnt handles ahead of time.
+     *
+     * @return number of handles actually created, can be less than cnt
+     *         if curl_t::create_easy() failed.
+     */
+    auto reserve(std::size_t cnt) noexcept -> std::size_t;
+
+    /**
+     * @return an idle handle if there is one, or newly created one.
+     *         <br>nullptr if there's no idle handle and curl_t::create_easy() failed.
+     */
+    auto get_easy() noexcept -> Easy_t;
+    /**
+     * @param easy must not be nullptr and must not be added to any Multi_t
+     *             or Share_base.
+     *
+     * easy would be reset before stored.
+     */
+    void recycle(Easy_t &&easy) noexcept;
+
+    /**
+     * @return number of handles idle in this pool, excluding those
+     *         cached in Easy_pool::Cache.
+     */
+    auto get_number_of_idle_easy() noexcept -> std::size_t;
+
+    /**
+     * All Easy_pool::Cache must be destroyed before this pool.
+     */
+    ~Easy_pool();
+};
+
+/**
+ * Per-thread cache of Easy_pool.
+ *
+ * When empty, it takes batch_size handles from Easy_pool at once.
+ * <br>When it holds more than 2 * batch_size handles, it returns
+ * batch_size handles to Easy_pool at once.
+ *
+ * Thus in steady state, handles are neither created nor freed, and
+ * Easy_pool is rarely locked.
+ *
+ * Easy_pool::Cache is not thread-safe.
+ */
+class Easy_pool::Cache {
+protected:
+    Easy_pool &pool;
+    const std::size_t batch_size;
+
+    char *idle_list = nullptr;
+    std::size_t idle_cnt = 0;
+
+public:
+    /**
+     * @param batch_size must be > 0
+     */
+    Cache(Easy_pool &pool, std::size_t batch_size = 8) noexcept;
+
+    Cache(const Cache&) = delete;
+    Cache(Cache&&) = delete;
+
+    Cache& operator = (const Cache&) = delete;
+    Cache& operator = (Cache&&) = delete;
+
+    /**
+     * @return same as Easy_pool::get_easy()
+     */
+    auto get_easy() noexcept -> Easy_t;
+    /**
+     * @param easy same as Easy_pool::recycle()
+     */
+    void recycle(Easy_t &&easy) noexcept;
+
+    /**
+     * Return all handles in this cache to Easy_pool.
+     */
+    void flush() noexcept;
+
+    /**
+     * @param perform_callback Must be callable with (Easy_ref_t&, Easy_ref_t::perform_ret_t, Multi_t&, T)
+     *                         <br>Must not remove easy_ref from multi.
+     * @return perform_callback for Multi_t::perform or Multi_t::multi_socket_action,
+     *         which calls perform_callback, then remove the easy from multi and recycle it.
+     *
+     * The returned callback takes ownership of every easy handle it is invoked with,
+     * thus you should call Easy_t::release() after adding the easy to Multi_t.
+     *
+     * The returned callback refers to this Cache.
+     */
+    template <class perform_callback_t>
+    auto recycle_on_finished(perform_callback_t &&perform_callback) noexcept
+    {
+        return [this, callback = std::forward<perform_callback_t>(perform_callback)]
+            (Easy_ref_t &easy_ref, Easy_ref_t::perform_ret_t ret, Multi_t &multi, auto &&arg) mutable
+        {
+            callback(easy_ref, std::move(ret), multi, std::forward<decltype(arg)>(arg));
+
+            multi.remove_easy(easy_ref);
+            recycle(Easy_t{easy_ref.curl_easy});
+        };
+    }
+
+    /**
+     * Calls flush().
+     */
+    ~Cache();
+};
+} /* namespace curl */
+
+#endif
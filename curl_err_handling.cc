@@ -72,6 +72,10 @@ auto Easy_ref_t::check_perform(long code, const char *fname) noexcept -> perform
         case CURLE_SSL_PINNEDPUBKEYNOTMATCH:
             return {code::ssl_pinned_pubkey_mismatch};
 
+        case CURLE_RANGE_ERROR:
+        case CURLE_BAD_DOWNLOAD_RESUME:
+            return {code::range_error};
+
         default:
             return {Exception{code}};
 
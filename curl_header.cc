@@ -0,0 +1,219 @@
+#include "curl_header.hpp"
+
+#include <cstring>
+#include <strings.h>
+
+#ifdef __SSE2__
+# include <emmintrin.h>
+#endif
+
+namespace curl {
+/**
+ * @return index of the first occurence of a, b or c in [p, p + n),
+ *         or n if not found.
+ */
+static std::size_t find_first_of(const char *p, std::size_t n, char a, char b, char c) noexcept
+{
+    std::size_t i = 0;
+
+#ifdef __SSE2__
+    const __m128i va = _mm_set1_epi8(a);
+    const __m128i vb = _mm_set1_epi8(b);
+    const __m128i vc = _mm_set1_epi8(c);
+
+    for (; i + 16 <= n; i += 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+        __m128i matched = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, va), _mm_cmpeq_epi8(chunk, vb)),
+                                       _mm_cmpeq_epi8(chunk, vc));
+
+        unsigned mask = _mm_movemask_epi8(matched);
+        if (mask)
+            return i + __builtin_ctz(mask);
+    }
+#endif
+
+    for (; i != n; ++i)
+        if (p[i] == a || p[i] == b || p[i] == c)
+            return i;
+
+    return n;
+}
+
+static bool is_space(char c) noexcept
+{
+    return c == ' ' || c == '\t';
+}
+static auto trim(const char *p, std::size_t n) noexcept -> std::string_view
+{
+    while (n && is_space(*p)) {
+        ++p;
+        --n;
+    }
+    while (n && is_space(p[n - 1]))
+        --n;
+    return {p, n};
+}
+
+Response_headers_base::Response_headers_base(char *buffer_arg, std::size_t buffer_size_arg,
+                                             Field *fields_arg, std::size_t max_fields_arg) noexcept:
+    buffer{buffer_arg},
+    buffer_size{buffer_size_arg},
+    fields{fields_arg},
+    max_fields{max_fields_arg}
+{}
+
+void Response_headers_base::attach(Easy_ref_t &easy) noexcept
+{
+    easy.set_header_writeback([](char *buffer, std::size_t _, std::size_t size, void *ptr) {
+        static_cast<Response_headers_base*>(ptr)->parse_line(buffer, size);
+        return size;
+    }, this);
+}
+
+void Response_headers_base::clear() noexcept
+{
+    buffer_len = 0;
+    field_cnt = 0;
+
+    version = {};
+    reason = {};
+    status_code = 0;
+
+    complete = false;
+    truncated = false;
+}
+
+auto Response_headers_base::store(const char *data, std::size_t len) noexcept -> char*
+{
+    if (buffer_size - buffer_len < len) {
+        truncated = true;
+        return nullptr;
+    }
+
+    char *dest = buffer + buffer_len;
+    std::memcpy(dest, data, len);
+    buffer_len += len;
+
+    return dest;
+}
+
+void Response_headers_base::parse_status_line(const char *line, std::size_t len) noexcept
+{
+    clear();
+
+    // Only the part before CRLF is stored
+    len = find_first_of(line, len, '\r', '\n', '\n');
+
+    const char *stored = store(line, len);
+    if (!stored)
+        return;
+
+    std::size_t version_len = find_first_of(stored, len, ' ', ' ', ' ');
+    version = {stored, version_len};
+
+    std::size_t i = version_len;
+    while (i != len && is_space(stored[i]))
+        ++i;
+
+    // Status code is exactly 3 digits, anything else is treated as 0.
+    long code = 0;
+    std::size_t digits = 0;
+    for (; i != len && stored[i] >= '0' && stored[i] <= '9'; ++i, ++digits)
+        if (digits < 3)
+            code = code * 10 + (stored[i] - '0');
+    status_code = (digits == 3 && code >= 100) ? code : 0;
+
+    reason = trim(stored + i, len - i);
+}
+void Response_headers_base::parse_field(const char *line, std::size_t len) noexcept
+{
+    std::size_t colon = find_first_of(line, len, ':', '\r', '\n');
+    if (colon == len || line[colon] != ':' || colon == 0)
+        return;
+
+    const char *value_begin = line + colon + 1;
+    std::size_t value_len = find_first_of(value_begin, len - colon - 1, '\r', '\n', '\n');
+
+    auto name = trim(line, colon);
+    auto value = trim(value_begin, value_len);
+
+    if (field_cnt == max_fields) {
+        truncated = true;
+        return;
+    }
+
+    // Both name and value are stored contiguously
+    char *stored = store(name.data(), name.size() + value.size());
+    if (!stored)
+        return;
+    std::memcpy(stored + name.size(), value.data(), value.size());
+
+    fields[field_cnt++] = Field{{stored, name.size()}, {stored + name.size(), value.size()}};
+}
+
+void Response_headers_base::parse_line(const char *line, std::size_t len) noexcept
+{
+    if (len == 0)
+        return;
+
+    if (line[0] == '\r' || line[0] == '\n')
+        complete = true;
+    else if (is_space(line[0]))
+        return; // Header folding is not supported
+    else if (len >= 5 && strncasecmp(line, "HTTP/", 5) == 0)
+        parse_status_line(line, len);
+    else
+        parse_field(line, len);
+}
+
+bool Response_headers_base::is_complete() const noexcept
+{
+    return complete;
+}
+bool Response_headers_base::is_truncated() const noexcept
+{
+    return truncated;
+}
+
+long Response_headers_base::get_status_code() const noexcept
+{
+    return status_code;
+}
+auto Response_headers_base::get_version() const noexcept -> std::string_view
+{
+    return version;
+}
+auto Response_headers_base::get_reason() const noexcept -> std::string_view
+{
+    return reason;
+}
+
+auto Response_headers_base::size() const noexcept -> std::size_t
+{
+    return field_cnt;
+}
+
+auto Response_headers_base::begin() const noexcept -> const Field*
+{
+    return fields;
+}
+auto Response_headers_base::end() const noexcept -> const Field*
+{
+    return fields + field_cnt;
+}
+
+auto Response_headers_base::find(std::string_view name) const noexcept -> const Field*
+{
+    for (const auto &field: *this)
+        if (field.name.size() == name.size() &&
+            strncasecmp(field.name.data(), name.data(), name.size()) == 0)
+            return &field;
+
+    return nullptr;
+}
+auto Response_headers_base::get(std::string_view name) const noexcept -> std::string_view
+{
+    auto *field = find(name);
+    return field ? field->value : std::string_view{};
+}
+} /* namespace curl */
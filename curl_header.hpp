@@ -0,0 +1,151 @@
+#ifndef  __curl_cpp_curl_header_HPP__
+# define __curl_cpp_curl_header_HPP__
+
+# include "curl.hpp"
+# include "curl_easy.hpp"
+
+# include <cstddef>
+# include <string_view>
+
+namespace curl {
+/**
+ * @example curl_header.cc
+ *
+ * Response_headers_base parses response headers delivered by libcurl
+ * into a flat array of Field, without any allocation.
+ *
+ * The storage of parsed headers is fixed-size and is provided by the derived
+ * class Response_headers.
+ * <br>If it is exhausted, the rest of the headers are dropped and is_truncated() returns true.
+ *
+ * When a new response begins (on redirection or "100 Continue"), all previously parsed headers
+ * are discarded, thus only headers of the last response are kept.
+ *
+ * Header folding (obsolete line continuation) is not supported, such lines are ignored.
+ *
+ * Response_headers_base's member function cannot be called in multiple threads simultaneously.
+ */
+class Response_headers_base {
+public:
+    struct Field {
+        std::string_view name;
+        /**
+         * Leading and trailing whitespaces are removed.
+         */
+        std::string_view value;
+    };
+
+protected:
+    char * const buffer;
+    const std::size_t buffer_size;
+    Field * const fields;
+    const std::size_t max_fields;
+
+    std::size_t buffer_len = 0;
+    std::size_t field_cnt = 0;
+
+    std::string_view version;
+    std::string_view reason;
+    long status_code = 0;
+
+    bool complete = false;
+    bool truncated = false;
+
+    Response_headers_base(char *buffer, std::size_t buffer_size, Field *fields, std::size_t max_fields) noexcept;
+
+    /**
+     * @return nullptr if there isn't enough space
+     */
+    auto store(const char *data, std::size_t len) noexcept -> char*;
+
+    void parse_status_line(const char *line, std::size_t len) noexcept;
+    void parse_field(const char *line, std::size_t len) noexcept;
+
+public:
+    Response_headers_base(const Response_headers_base&) = delete;
+    Response_headers_base(Response_headers_base&&) = delete;
+
+    Response_headers_base& operator = (const Response_headers_base&) = delete;
+    Response_headers_base& operator = (Response_headers_base&&) = delete;
+
+    /**
+     * Set header writeback of easy to parse_line().
+     *
+     * This object must be kept around until the transfer is done or
+     * header writeback of easy is changed.
+     *
+     * Headers parsed previously are not cleared, so you should call clear()
+     * before reusing this object for another transfer.
+     */
+    void attach(Easy_ref_t &easy) noexcept;
+
+    /**
+     * Discard all parsed headers.
+     */
+    void clear() noexcept;
+
+    /**
+     * @param line a single CRLF-terminated header line, not null-terminated.
+     *
+     * It is called by the header writeback set by attach(),
+     * but can also be used to feed headers manually.
+     */
+    void parse_line(const char *line, std::size_t len) noexcept;
+
+    /**
+     * @return true if the empty line ending headers is received.
+     */
+    bool is_complete() const noexcept;
+    /**
+     * @return true if some headers are dropped due to lack of storage.
+     */
+    bool is_truncated() const noexcept;
+
+    /**
+     * @return 0 if status line is not received or its status code is not
+     *         3 digits within 100..999.
+     */
+    long get_status_code() const noexcept;
+    /**
+     * @return e.g. "HTTP/1.1", "HTTP/2"
+     */
+    auto get_version() const noexcept -> std::string_view;
+    /**
+     * @return reason phrase, can be empty (HTTP/2 does not have one).
+     */
+    auto get_reason() const noexcept -> std::string_view;
+
+    auto size() const noexcept -> std::size_t;
+
+    auto begin() const noexcept -> const Field*;
+    auto end() const noexcept -> const Field*;
+
+    /**
+     * @param name is compared case-insensitively.
+     * @return first field with name, or nullptr if not found.
+     */
+    auto find(std::string_view name) const noexcept -> const Field*;
+    /**
+     * @param name is compared case-insensitively.
+     * @return value of first field with name, or empty string_view if not found.
+     */
+    auto get(std::string_view name) const noexcept -> std::string_view;
+};
+
+/**
+ * @tparam Buffer_size bytes to store name and value of fields, status line and reason.
+ * @tparam Max_fields maximum number of fields that can be stored.
+ */
+template <std::size_t Buffer_size = 4096, std::size_t Max_fields = 64>
+class Response_headers: public Response_headers_base {
+    char buffer_storage[Buffer_size];
+    Field fields_storage[Max_fields];
+
+public:
+    Response_headers() noexcept:
+        Response_headers_base{buffer_storage, Buffer_size, fields_storage, Max_fields}
+    {}
+};
+} /* namespace curl */
+
+#endif
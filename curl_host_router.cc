@@ -0,0 +1,86 @@
+#include "curl_host_router.hpp"
+
+#include <algorithm>
+
+namespace curl {
+static constexpr auto mix(std::uint64_t x) noexcept -> std::uint64_t
+{
+    // Finalizer of splitmix64
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111eb;
+    x ^= x >> 31;
+    return x;
+}
+
+auto Host_router::hash(std::string_view host) noexcept -> std::uint64_t
+{
+    // FNV-1a
+    std::uint64_t h = 0xcbf29ce484222325;
+    for (unsigned char c: host) {
+        h ^= c;
+        h *= 0x100000001b3;
+    }
+    return mix(h);
+}
+
+Host_router::Host_router(std::size_t shards, std::size_t vnodes_arg) noexcept:
+    shard_cnt{shards},
+    vnodes{vnodes_arg}
+{}
+
+auto Host_router::init() noexcept -> Ret_except<void, std::bad_alloc>
+{
+    const std::size_t ring_size = shard_cnt * vnodes;
+
+    ring.reset(new (std::nothrow) Vnode[ring_size]);
+    if (!ring)
+        return {std::bad_alloc{}};
+
+    for (std::size_t shard = 0; shard != shard_cnt; ++shard)
+        for (std::size_t i = 0; i != vnodes; ++i)
+            ring[shard * vnodes + i] = Vnode{mix((std::uint64_t{shard} << 32) | i), shard};
+
+    std::sort(ring.get(), ring.get() + ring_size, [](const Vnode &x, const Vnode &y) noexcept {
+        return x.hash < y.hash;
+    });
+
+    return {};
+}
+
+auto Host_router::get_number_of_shards() const noexcept -> std::size_t
+{
+    return shard_cnt;
+}
+
+auto Host_router::get_authority(std::string_view url) noexcept -> std::string_view
+{
+    if (auto pos = url.find("://"); pos != std::string_view::npos)
+        url.remove_prefix(pos + 3);
+
+    url = url.substr(0, url.find_first_of("/?#"));
+
+    if (auto pos = url.rfind('@'); pos != std::string_view::npos)
+        url.remove_prefix(pos + 1);
+
+    return url;
+}
+
+auto Host_router::find(std::string_view host) const noexcept -> std::size_t
+{
+    const std::size_t ring_size = shard_cnt * vnodes;
+    const auto h = hash(host);
+
+    auto *it = std::lower_bound(ring.get(), ring.get() + ring_size, h, [](const Vnode &vnode, std::uint64_t h) noexcept {
+        return vnode.hash < h;
+    });
+
+    return (it - ring.get()) % ring_size;
+}
+
+auto Host_router::get_home(std::string_view host) const noexcept -> std::size_t
+{
+    return ring[find(host)].shard;
+}
+} /* namespace curl */
@@ -0,0 +1,110 @@
+#ifndef  __curl_cpp_curl_host_router_HPP__
+# define __curl_cpp_curl_host_router_HPP__
+
+# include "return-exception/ret-exception.hpp"
+
+# include <cstddef>
+# include <cstdint>
+# include <memory>
+# include <new>
+# include <string_view>
+
+namespace curl {
+/**
+ * @example curl_host_router.cc
+ *
+ * Host_router maps hosts to shards (e.g. shards of Multi_runtime) by consistent hashing,
+ * so that requests to the same host go to the same Multi_t and reuse its connections.
+ *
+ * Each shard is placed on a hash ring vnodes times, and a host is mapped to
+ * the first shard clockwise from its hash (its home).
+ * <br>When a shard is added or removed, only hosts in its ranges are remapped.
+ *
+ * route() implements consistent hashing with bounded loads: if the home
+ * of a host is at capacity, the next shard clockwise that is not is used instead.
+ *
+ * Host_router is immutable after init(), thus thread-safe.
+ */
+class Host_router {
+public:
+    static constexpr const std::size_t default_vnodes = 64;
+
+protected:
+    struct Vnode {
+        std::uint64_t hash;
+        std::size_t shard;
+    };
+
+    const std::size_t shard_cnt;
+    const std::size_t vnodes;
+
+    std::unique_ptr<Vnode[]> ring;
+
+    static auto hash(std::string_view host) noexcept -> std::uint64_t;
+
+    /**
+     * @return index of the first vnode clockwise from the hash of host.
+     */
+    auto find(std::string_view host) const noexcept -> std::size_t;
+
+public:
+    /**
+     * @param shards must not be 0.
+     * @param vnodes number of points of each shard on the ring, higher value
+     *               makes the mapping more uniform.
+     */
+    Host_router(std::size_t shards, std::size_t vnodes = default_vnodes) noexcept;
+
+    Host_router(const Host_router&) = delete;
+    Host_router& operator = (const Host_router&) = delete;
+
+    /**
+     * Build the ring.
+     */
+    auto init() noexcept -> Ret_except<void, std::bad_alloc>;
+
+    auto get_number_of_shards() const noexcept -> std::size_t;
+
+    /**
+     * @return host and port of url, without userinfo.
+     *         <br>url without scheme is accepted, e.g. "localhost:8787/".
+     *
+     * Url_ref_t::get_host() and Url_ref_t::get_port() can be used
+     * for Url_ref_t.
+     *
+     * Hostnames are not case-folded, so "Example.com" and "example.com"
+     * are different hosts.
+     */
+    static auto get_authority(std::string_view url) noexcept -> std::string_view;
+
+    /**
+     * @pre init() is called.
+     * @return shard the host is mapped to regardless of load.
+     */
+    auto get_home(std::string_view host) const noexcept -> std::size_t;
+
+    /**
+     * @pre init() is called.
+     * @param capacity max load of a shard.
+     * @param get_load callable with (std::size_t shard), returns its current load.
+     * @return the first shard clockwise from the hash of host with
+     *         get_load(shard) < capacity, or home if all shards are at capacity.
+     */
+    template <class Get_load>
+    auto route(std::string_view host, std::size_t capacity, Get_load &&get_load) const noexcept ->
+        std::size_t
+    {
+        const std::size_t ring_size = shard_cnt * vnodes;
+        const std::size_t start = find(host);
+
+        for (std::size_t i = 0; i != ring_size; ++i) {
+            auto shard = ring[(start + i) % ring_size].shard;
+            if (get_load(shard) < capacity)
+                return shard;
+        }
+        return ring[start].shard;
+    }
+};
+} /* namespace curl */
+
+#endif
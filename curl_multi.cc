@@ -99,6 +99,11 @@ auto Multi_t::break_or_poll(curl_waitfd *extra_fds, unsigned extra_nfds, int tim
         return poll(extra_fds, extra_nfds, timeout);
 }
 
+bool Multi_t::wakeup() noexcept
+{
+    return curl_multi_wakeup(curl_multi) == CURLM_OK;
+}
+
 auto Multi_t::get_finished_easy() const noexcept -> std::pair<Easy_ref_t, Easy_ref_t::perform_ret_t>
 {
     int msgq = 0;
@@ -110,6 +115,20 @@ auto Multi_t::get_finished_easy() const noexcept -> std::pair<Easy_ref_t, Easy_r
 
     return {Easy_ref_t{nullptr}, Easy_ref_t::perform_ret_t{Easy_ref_t::code::ok}};
 }
+auto Multi_t::Finished_easy::get_result() const noexcept -> Easy_ref_t::perform_ret_t
+{
+    return easy_ref.check_perform(code, "");
+}
+auto Multi_t::get_finished_easies(Finished_easy *finished, std::size_t n) noexcept -> std::size_t
+{
+    std::size_t cnt = 0;
+    int msgq = 0;
+    for (CURLMsg *m; cnt != n && (m = curl_multi_info_read(curl_multi, &msgq)); )
+        if (m->msg == CURLMSG_DONE)
+            finished[cnt++] = Finished_easy{Easy_ref_t{static_cast<char*>(m->easy_handle)}, m->data.result};
+
+    return cnt;
+}
 auto Multi_t::check_perform(long code, int running_handles, const char *fname) noexcept -> 
     Ret_except<int, std::bad_alloc, Exception, Recursive_api_call_Exception, libcurl_bug>
 {
@@ -133,6 +152,10 @@ auto Multi_t::perform_impl() noexcept ->  perform_ret_t
 
     return check_perform(code, running_handles, "In curl_multi_perform");
 }
+auto Multi_t::perform() noexcept -> perform_ret_t
+{
+    return perform_impl();
+}
 
 /* Interface for using arbitary event-based interface - multi_socket interface */
 void Multi_t::register_callback(socket_callback_t socket_callback, void *socket_data,
@@ -164,4 +187,8 @@ auto Multi_t::multi_socket_action_impl(curl_socket_t socketfd, int ev_bitmask) n
 
     return check_perform(code, running_handles, "In curl_multi_socket_action");
 }
+auto Multi_t::multi_socket_action(curl_socket_t socketfd, int ev_bitmask) noexcept -> perform_ret_t
+{
+    return multi_socket_action_impl(socketfd, ev_bitmask);
+}
 } /* namespace curl */
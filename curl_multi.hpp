@@ -11,6 +11,7 @@ namespace curl {
  * @example curl_multi_socket_action_epoll.cc
  * @example curl_multi_socket_action_event.cc
  * @example curl_multi_socket_action_uv.cc
+ * @example curl_multi_finished_batch.cc
  *
  * Multi_t enables user to simultaneously do multiple request
  * in the same thread, using any polling interface they prefer.
@@ -44,6 +45,22 @@ public:
 
     using perform_ret_t = Ret_except<int, std::bad_alloc, Exception, Recursive_api_call_Exception, libcurl_bug>;
 
+    /**
+     * Record of a finished transfer, filled by get_finished_easies().
+     */
+    struct Finished_easy {
+        Easy_ref_t easy_ref;
+        /**
+         * CURLcode of the transfer.
+         */
+        long code;
+
+        /**
+         * @return same as the perform_ret_t passed to perform_callback.
+         */
+        auto get_result() const noexcept -> Easy_ref_t::perform_ret_t;
+    };
+
 protected:
     void *curl_multi = nullptr;
     std::size_t handles = 0;
@@ -161,6 +178,17 @@ public:
     auto break_or_poll(curl_waitfd *extra_fds = nullptr, unsigned extra_nfds = 0U, int timeout = 0) noexcept -> 
         Ret_except<int, std::bad_alloc, libcurl_bug>;
 
+    /**
+     * @pre curl_t::has_multi_wakeup_support()
+     * @return false if failed to wake up.
+     *
+     * Make poll() or break_or_poll() in another thread return immediately.
+     * <br>If no poll() is in progress, the next call to it returns immediately.
+     *
+     * This is the only member function that can be called from another thread.
+     */
+    bool wakeup() noexcept;
+
     /**
      * @pre perform_callback is set.
      *
@@ -190,6 +218,23 @@ public:
         callback_on_finished_easy(std::forward<perform_callback_t>(perform_callback), std::forward<T>(arg));
         return ret;
     }
+    /**
+     * Same as perform(perform_callback, arg), except that finished transfers
+     * are left for get_finished_easies() instead.
+     */
+    auto perform() noexcept -> perform_ret_t;
+
+    /**
+     * @param finished array of at least n records.
+     * @return number of records filled, finished transfers beyond n
+     *         are left for the next call.
+     *
+     * Retrieve finished transfers after perform() or multi_socket_action()
+     * in one pass, so that they can be processed in bulk.
+     *
+     * Handles are not removed, the same rule as perform_callback applies.
+     */
+    auto get_finished_easies(Finished_easy *finished, std::size_t n) noexcept -> std::size_t;
 
     /** 
      * @return should be 0
@@ -281,6 +326,11 @@ public:
         callback_on_finished_easy(std::forward<perform_callback_t>(perform_callback), std::forward<T>(arg));
         return ret;
     }
+    /**
+     * Same as multi_socket_action(socketfd, ev_bitmask, perform_callback, arg),
+     * except that finished transfers are left for get_finished_easies() instead.
+     */
+    auto multi_socket_action(curl_socket_t socketfd, int ev_bitmask) noexcept -> perform_ret_t;
 
     /**
      * @pre get_number_of_handles() == 0
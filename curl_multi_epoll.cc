@@ -0,0 +1,179 @@
+#include "curl_multi_epoll.hpp"
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+
+#include <unistd.h>
+#include <sys/timerfd.h>
+
+namespace curl {
+Multi_epoll_t::Multi_epoll_t(Multi_t &multi_arg, std::size_t max_events_arg) noexcept:
+    multi{multi_arg},
+    max_events{max_events_arg}
+{}
+
+auto Multi_epoll_t::init() noexcept -> Ret_except<void, std::bad_alloc, std::system_error>
+{
+    events = static_cast<struct epoll_event*>(std::malloc(max_events * sizeof(struct epoll_event)));
+    if (!events)
+        return {std::bad_alloc{}};
+
+    epfd = epoll_create1(EPOLL_CLOEXEC);
+    if (epfd == -1)
+        return {std::system_error{errno, std::generic_category(), "In curl::Multi_epoll_t::init: epoll_create1 failed"}};
+
+    timerfd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (timerfd == -1)
+        return {std::system_error{errno, std::generic_category(), "In curl::Multi_epoll_t::init: timerfd_create failed"}};
+
+    struct epoll_event event;
+    event.events = EPOLLIN;
+    event.data.fd = timerfd;
+    if (epoll_ctl(epfd, EPOLL_CTL_ADD, timerfd, &event) == -1)
+        return {std::system_error{errno, std::generic_category(), "In curl::Multi_epoll_t::init: epoll_ctl failed"}};
+
+    multi.register_callback(socket_callback, this, timer_callback, this);
+
+    return {};
+}
+
+int Multi_epoll_t::get_fd() const noexcept
+{
+    return epfd;
+}
+
+bool Multi_epoll_t::update_interest(int fd, std::uint8_t interest) noexcept
+{
+    if (static_cast<std::size_t>(fd) >= interests_size) {
+        if (interest == 0)
+            return true;
+
+        std::size_t new_size = interests_size ? interests_size : 64;
+        while (new_size <= static_cast<std::size_t>(fd))
+            new_size *= 2;
+
+        auto *p = static_cast<std::uint8_t*>(std::realloc(interests, new_size));
+        if (!p)
+            return false;
+        std::memset(p + interests_size, 0, new_size - interests_size);
+
+        interests = p;
+        interests_size = new_size;
+    }
+
+    auto &old_interest = interests[fd];
+    if (old_interest == interest)
+        return true;
+
+    int op;
+    if (interest == 0)
+        op = EPOLL_CTL_DEL;
+    else if (old_interest == 0)
+        op = EPOLL_CTL_ADD;
+    else
+        op = EPOLL_CTL_MOD;
+
+    struct epoll_event event;
+    event.events = interest;
+    event.data.fd = fd;
+    // The socket might have already been closed when being removed.
+    if (epoll_ctl(epfd, op, fd, &event) == -1 && op != EPOLL_CTL_DEL)
+        return false;
+
+    old_interest = interest;
+    return true;
+}
+
+int Multi_epoll_t::socket_callback(CURL *curl_easy, curl_socket_t s, int what, void *userp, void *per_socketp) noexcept
+{
+    std::uint8_t interest = 0;
+    switch (what) {
+        case CURL_POLL_IN:
+            interest = EPOLLIN;
+            break;
+
+        case CURL_POLL_OUT:
+            interest = EPOLLOUT;
+            break;
+
+        case CURL_POLL_INOUT:
+            interest = EPOLLIN | EPOLLOUT;
+            break;
+
+        case CURL_POLL_REMOVE:
+        default:
+            break;
+    }
+
+    return static_cast<Multi_epoll_t*>(userp)->update_interest(s, interest) ? 0 : -1;
+}
+
+bool Multi_epoll_t::set_timer(long timeout_ms) noexcept
+{
+    struct itimerspec spec = {};
+
+    if (timeout_ms == 0)
+        // it_value of 0 disarms the timer, so use the shortest delay instead.
+        spec.it_value.tv_nsec = 1;
+    else if (timeout_ms > 0) {
+        spec.it_value.tv_sec = timeout_ms / 1000;
+        spec.it_value.tv_nsec = (timeout_ms % 1000) * 1000000;
+    }
+
+    return timerfd_settime(timerfd, 0, &spec, nullptr) == 0;
+}
+int Multi_epoll_t::timer_callback(CURLM *curl_multi, long timeout_ms, void *userp) noexcept
+{
+    return static_cast<Multi_epoll_t*>(userp)->set_timer(timeout_ms) ? 0 : -1;
+}
+
+auto Multi_epoll_t::wait(int timeout) noexcept -> Ret_except<std::size_t, std::system_error>
+{
+    int cnt = epoll_wait(epfd, events, max_events, timeout);
+    if (cnt == -1) {
+        if (errno == EINTR)
+            cnt = 0;
+        else
+            return {std::system_error{errno, std::generic_category(), "In curl::Multi_epoll_t::wait: epoll_wait failed"}};
+    }
+
+    event_cnt = cnt;
+    return {event_cnt};
+}
+
+auto Multi_epoll_t::translate_event(std::size_t i) noexcept -> std::pair<curl_socket_t, int>
+{
+    const auto &event = events[i];
+
+    if (event.data.fd == timerfd) {
+        std::uint64_t expirations;
+        read(timerfd, &expirations, sizeof(expirations));
+        return {CURL_SOCKET_TIMEOUT, 0};
+    }
+
+    int ev_bitmask = 0;
+    if (event.events & EPOLLIN)
+        ev_bitmask |= CURL_CSELECT_IN;
+    if (event.events & EPOLLOUT)
+        ev_bitmask |= CURL_CSELECT_OUT;
+    if (event.events & (EPOLLERR | EPOLLHUP))
+        ev_bitmask |= CURL_CSELECT_ERR;
+
+    return {event.data.fd, ev_bitmask};
+}
+
+Multi_epoll_t::~Multi_epoll_t()
+{
+    if (epfd != -1)
+        multi.register_callback(nullptr, nullptr, nullptr, nullptr);
+
+    if (timerfd != -1)
+        close(timerfd);
+    if (epfd != -1)
+        close(epfd);
+
+    std::free(interests);
+    std::free(events);
+}
+} /* namespace curl */
@@ -0,0 +1,147 @@
+#ifndef  __curl_cpp_curl_multi_epoll_HPP__
+# define __curl_cpp_curl_multi_epoll_HPP__
+
+# include "curl_multi.hpp"
+
+# include <cstddef>
+# include <cstdint>
+# include <new>
+# include <utility>
+# include <system_error>
+
+# include <sys/epoll.h>
+
+namespace curl {
+/**
+ * @example curl_multi_epoll.cc
+ *
+ * Multi_epoll_t drives Multi_t's multi_socket_action interface with epoll:
+ *  - the timeout requested by libcurl is armed on a timerfd, which is
+ *    polled together with the sockets;
+ *  - interest of each socket is cached in a table indexed by fd, so
+ *    epoll_ctl is only called when the interest actually changes, and
+ *    Multi_t::multi_assign is never used;
+ *  - wait() retrieves up to max_events events in one epoll_wait, which are then
+ *    processed by perform().
+ *
+ * Usage:
+ *
+ *     epoll.init().get_return_value();
+ *     epoll.start(perform_callback, arg);
+ *     while (multi.get_number_of_handles()) {
+ *         epoll.wait(-1).get_return_value();
+ *         epoll.perform(perform_callback, arg);
+ *     }
+ *
+ * @pre curl_t::has_multi_socket_support()
+ *
+ * Multi_epoll_t must not be moved after init(), and Multi_t must not be used with
+ * any other polling interface.
+ */
+class Multi_epoll_t {
+protected:
+    Multi_t &multi;
+
+    int epfd = -1;
+    int timerfd = -1;
+
+    /**
+     * Registered epoll events indexed by fd, 0 if not registered.
+     */
+    std::uint8_t *interests = nullptr;
+    std::size_t interests_size = 0;
+
+    struct epoll_event *events = nullptr;
+    const std::size_t max_events;
+    std::size_t event_cnt = 0;
+
+    static int socket_callback(CURL *curl_easy, curl_socket_t s, int what, void *userp, void *per_socketp) noexcept;
+    static int timer_callback(CURLM *curl_multi, long timeout_ms, void *userp) noexcept;
+
+    /**
+     * @return false on error.
+     */
+    bool update_interest(int fd, std::uint8_t interest) noexcept;
+    bool set_timer(long timeout_ms) noexcept;
+
+    /**
+     * @param i index into events
+     * @return fd and ev_bitmask for Multi_t::multi_socket_action.
+     */
+    auto translate_event(std::size_t i) noexcept -> std::pair<curl_socket_t, int>;
+
+public:
+    /**
+     * @param max_events max number of events retrieved by one wait().
+     */
+    Multi_epoll_t(Multi_t &multi, std::size_t max_events = 64) noexcept;
+
+    Multi_epoll_t(const Multi_epoll_t&) = delete;
+    Multi_epoll_t(Multi_epoll_t&&) = delete;
+
+    Multi_epoll_t& operator = (const Multi_epoll_t&) = delete;
+    Multi_epoll_t& operator = (Multi_epoll_t&&) = delete;
+
+    /**
+     * Create epoll and timerfd and register callbacks to multi.
+     *
+     * Must be called before any easy handle is added to multi.
+     */
+    auto init() noexcept -> Ret_except<void, std::bad_alloc, std::system_error>;
+
+    /**
+     * @return fd of epoll, which can be polled by another event loop.
+     */
+    int get_fd() const noexcept;
+
+    /**
+     * Start the transfer, must be called after easy handles are added.
+     *
+     * @param perform_callback, arg same as Multi_t::multi_socket_action.
+     */
+    template <class perform_callback_t, class T>
+    auto start(perform_callback_t &&perform_callback, T &&arg) noexcept -> Multi_t::perform_ret_t
+    {
+        return multi.multi_socket_action(CURL_SOCKET_TIMEOUT, 0,
+                                         std::forward<perform_callback_t>(perform_callback),
+                                         std::forward<T>(arg));
+    }
+
+    /**
+     * @param timeout in ms, -1 means infinite.
+     * @return number of events retrieved, 0 if timeout or interrupted by signal.
+     */
+    auto wait(int timeout = -1) noexcept -> Ret_except<std::size_t, std::system_error>;
+
+    /**
+     * Process events retrieved by the last wait().
+     *
+     * @param perform_callback, arg same as Multi_t::multi_socket_action.
+     * @return same as the last call to Multi_t::multi_socket_action, or 0 if there's no event.
+     *         <br>If an exception is returned, events left unprocessed would be
+     *         retrieved again by the next wait().
+     */
+    template <class perform_callback_t, class T>
+    auto perform(perform_callback_t &&perform_callback, T &&arg) noexcept -> Multi_t::perform_ret_t
+    {
+        for (std::size_t i = 0; i != event_cnt; ++i) {
+            auto [socketfd, ev_bitmask] = translate_event(i);
+            auto ret = multi.multi_socket_action(socketfd, ev_bitmask, perform_callback, arg);
+            if (ret.has_exception_set() || i + 1 == event_cnt) {
+                event_cnt = 0;
+                return ret;
+            }
+        }
+        return {0};
+    }
+
+    /**
+     * Unregister callbacks from multi and close epoll and timerfd.
+     *
+     * @pre multi.get_number_of_handles() == 0
+     */
+    ~Multi_epoll_t();
+};
+} /* namespace curl */
+
+#endif
@@ -0,0 +1,361 @@
+#include "curl_multi_runtime.hpp"
+
+#include <cerrno>
+#include <cstdlib>
+#include <utility>
+#include <algorithm>
+
+#include <sched.h>
+
+namespace curl {
+bool Multi_runtime::Shard::push_back(char *easy) noexcept
+{
+    if (pending_cnt == pending_capacity) {
+        std::size_t new_capacity = pending_capacity ? pending_capacity * 2 : 64;
+        auto *p = static_cast<char**>(std::malloc(new_capacity * sizeof(char*)));
+        if (!p)
+            return false;
+
+        for (std::size_t i = 0; i != pending_cnt; ++i)
+            p[i] = pending[(pending_head + i) % pending_capacity];
+        std::free(pending);
+
+        pending = p;
+        pending_head = 0;
+        pending_capacity = new_capacity;
+    }
+
+    pending[(pending_head + pending_cnt++) % pending_capacity] = easy;
+    queued.store(pending_cnt, std::memory_order_relaxed);
+
+    return true;
+}
+auto Multi_runtime::Shard::pop_front(char **out, std::size_t n) noexcept -> std::size_t
+{
+    std::lock_guard guard{mutex};
+
+    n = std::min(n, pending_cnt);
+    for (std::size_t i = 0; i != n; ++i) {
+        out[i] = pending[pending_head];
+        pending_head = (pending_head + 1) % pending_capacity;
+    }
+    pending_cnt -= n;
+    queued.store(pending_cnt, std::memory_order_relaxed);
+
+    return n;
+}
+auto Multi_runtime::Shard::steal(char **out, std::size_t n) noexcept -> std::size_t
+{
+    std::lock_guard guard{mutex};
+
+    n = std::min(n, (pending_cnt + 1) / 2);
+    for (std::size_t i = 0; i != n; ++i)
+        out[i] = pending[(pending_head + --pending_cnt) % pending_capacity];
+    queued.store(pending_cnt, std::memory_order_relaxed);
+
+    return n;
+}
+
+Multi_runtime::Shard::~Shard()
+{
+    std::free(pending);
+}
+
+static auto get_number_of_cpus() noexcept -> std::size_t
+{
+    cpu_set_t set;
+    if (sched_getaffinity(0, sizeof(set), &set) == -1)
+        return 1;
+    auto cnt = CPU_COUNT(&set);
+    return cnt > 0 ? cnt : 1;
+}
+
+Multi_runtime::Multi_runtime(curl_t &curl_arg, completion_t completion_arg, void *userp_arg,
+                             std::size_t shards_arg) noexcept:
+    curl{curl_arg},
+    completion{completion_arg},
+    userp{userp_arg},
+    shard_cnt{shards_arg ? shards_arg : get_number_of_cpus()},
+    router{shard_cnt}
+{}
+
+void Multi_runtime::set_share(Share_base *share_arg) noexcept
+{
+    share = share_arg;
+}
+void Multi_runtime::set_multiplexing(long max_concurrent_stream_arg) noexcept
+{
+    max_concurrent_stream = max_concurrent_stream_arg;
+}
+void Multi_runtime::set_max_inflight(std::size_t max_inflight_arg) noexcept
+{
+    max_inflight = max_inflight_arg;
+}
+void Multi_runtime::set_load_factor(double load_factor_arg) noexcept
+{
+    load_factor = load_factor_arg;
+}
+
+/**
+ * @param i index of cpu among cpus available to this process.
+ */
+static int pin_thread(pthread_t thread, std::size_t i) noexcept
+{
+    cpu_set_t available;
+    if (sched_getaffinity(0, sizeof(available), &available) == -1)
+        return errno;
+
+    const std::size_t cnt = CPU_COUNT(&available);
+    if (cnt == 0)
+        return 0;
+    i %= cnt;
+
+    for (int cpu = 0; cpu != CPU_SETSIZE; ++cpu) {
+        if (CPU_ISSET(cpu, &available) && i-- == 0) {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(cpu, &set);
+            return pthread_setaffinity_np(thread, sizeof(set), &set);
+        }
+    }
+    return 0;
+}
+
+auto Multi_runtime::start(bool pin_threads) noexcept ->
+    Ret_except<void, std::bad_alloc, std::system_error, curl::Exception>
+{
+    shards.reset(new (std::nothrow) Shard[shard_cnt]);
+    if (!shards)
+        return {std::bad_alloc{}};
+
+    bool oom = false;
+    router.init().Catch([&](std::bad_alloc) noexcept { oom = true; });
+    if (oom)
+        return {std::bad_alloc{}};
+
+    for (std::size_t i = 0; i != shard_cnt; ++i) {
+        auto &shard = shards[i];
+        shard.runtime = this;
+
+        bool failed = false;
+        auto result = curl.create_multi();
+        result.Catch([&](curl::Exception) noexcept { failed = true; });
+        if (failed)
+            return {curl::Exception{"In curl::Multi_runtime::start: curl_multi_init failed"}};
+        shard.multi = std::move(result).get_return_value();
+
+        if (max_concurrent_stream != -1)
+            shard.multi.set_multiplexing(max_concurrent_stream);
+    }
+
+    for (std::size_t i = 0; i != shard_cnt; ++i) {
+        auto &shard = shards[i];
+
+        int err = pthread_create(&shard.thread, nullptr, shard_main, &shard);
+        if (err != 0)
+            return {std::system_error{err, std::generic_category(),
+                                      "In curl::Multi_runtime::start: pthread_create failed"}};
+        shard.started = true;
+
+        if (pin_threads && (err = pin_thread(shard.thread, i)) != 0)
+            return {std::system_error{err, std::generic_category(),
+                                      "In curl::Multi_runtime::start: pthread_setaffinity_np failed"}};
+    }
+
+    return {};
+}
+
+auto Multi_runtime::get_number_of_shards() const noexcept -> std::size_t
+{
+    return shard_cnt;
+}
+
+auto Multi_runtime::submit(Easy_t &easy) noexcept -> Ret_except<void, std::bad_alloc>
+{
+    return submit(next_shard.fetch_add(1, std::memory_order_relaxed) % shard_cnt, easy);
+}
+auto Multi_runtime::submit(std::size_t i, Easy_t &easy) noexcept -> Ret_except<void, std::bad_alloc>
+{
+    auto &shard = shards[i];
+
+    Easy_ref_t easy_ref{easy.get()};
+    if (share)
+        share->add_easy(easy_ref);
+
+    // Count the load first, otherwise it could be decremented before incremented.
+    shard.load.fetch_add(1, std::memory_order_relaxed);
+
+    bool oom = false;
+    shard.inbox.push(easy).Catch([&](std::bad_alloc) noexcept { oom = true; });
+    if (oom) {
+        shard.load.fetch_sub(1, std::memory_order_relaxed);
+        if (share)
+            share->remove_easy(easy_ref);
+        return {std::bad_alloc{}};
+    }
+
+    return {};
+}
+
+auto Multi_runtime::route(std::string_view host) const noexcept -> std::size_t
+{
+    std::size_t total = 0;
+    for (std::size_t i = 0; i != shard_cnt; ++i)
+        total += shards[i].load.load(std::memory_order_relaxed);
+
+    const auto capacity = static_cast<std::size_t>(load_factor * (total + 1) / shard_cnt) + 1;
+
+    return router.route(host, capacity, [this](std::size_t shard) noexcept {
+        return shards[shard].load.load(std::memory_order_relaxed);
+    });
+}
+auto Multi_runtime::submit_to_host(std::string_view host, Easy_t &easy) noexcept -> Ret_except<void, std::bad_alloc>
+{
+    return submit(route(host), easy);
+}
+
+auto Multi_runtime::find_victim(const Shard &thief) noexcept -> Shard*
+{
+    Shard *victim = nullptr;
+    std::size_t max_queued = 0;
+
+    for (std::size_t i = 0; i != shard_cnt; ++i) {
+        auto &shard = shards[i];
+        if (&shard == &thief)
+            continue;
+
+        auto queued = shard.queued.load(std::memory_order_relaxed);
+        if (queued > max_queued) {
+            victim = &shard;
+            max_queued = queued;
+        }
+    }
+
+    return victim;
+}
+void Multi_runtime::wakeup_idle_shard() noexcept
+{
+    for (std::size_t i = 0; i != shard_cnt; ++i) {
+        auto &shard = shards[i];
+        if (shard.idle.exchange(false, std::memory_order_relaxed)) {
+            shard.multi.wakeup();
+            return;
+        }
+    }
+}
+
+void Multi_runtime::fill(Shard &shard) noexcept
+{
+    auto get_room = [&]() noexcept -> std::size_t {
+        if (max_inflight == 0)
+            return batch_size;
+        auto handles = shard.multi.get_number_of_handles();
+        return handles < max_inflight ? std::min(max_inflight - handles, batch_size) : 0;
+    };
+
+    auto add_batch = [&](std::size_t cnt) noexcept {
+        for (std::size_t i = 0; i != cnt; ++i) {
+            Easy_ref_t easy_ref{shard.batch[i]};
+            shard.multi.add_easy(easy_ref);
+        }
+    };
+
+    // Without max_inflight, requests submitted are added right away and never queued.
+    if (max_inflight == 0) {
+        shard.inbox.drain();
+        return;
+    }
+
+    {
+        std::lock_guard guard{shard.mutex};
+        shard.inbox.drain([&](Easy_ref_t &easy_ref) noexcept {
+            if (!shard.push_back(easy_ref.curl_easy))
+                // Out of memory, exceed max_inflight rather than dropping the request
+                shard.multi.add_easy(easy_ref);
+        });
+    }
+
+    for (std::size_t room, cnt; (room = get_room()) && (cnt = shard.pop_front(shard.batch, room)); )
+        add_batch(cnt);
+
+    for (std::size_t room; (room = get_room()); ) {
+        auto *victim = find_victim(shard);
+        if (!victim)
+            break;
+        auto cnt = victim->steal(shard.batch, room);
+        victim->load.fetch_sub(cnt, std::memory_order_relaxed);
+        shard.load.fetch_add(cnt, std::memory_order_relaxed);
+        add_batch(cnt);
+    }
+}
+void Multi_runtime::run(Shard &shard) noexcept
+{
+    auto on_finished = [](Easy_ref_t &easy_ref, Easy_ref_t::perform_ret_t ret, Multi_t &multi,
+                          Shard *shard) noexcept
+    {
+        multi.remove_easy(easy_ref);
+        shard->load.fetch_sub(1, std::memory_order_relaxed);
+
+        auto &runtime = *shard->runtime;
+        runtime.completion(Easy_t{easy_ref.curl_easy}, std::move(ret), runtime.userp);
+    };
+
+    for (;;) {
+        // Read stopping before filling, so that requests submitted before stop() is called
+        // are never left behind.
+        const bool stop = stopping.load(std::memory_order_acquire);
+
+        fill(shard);
+        shard.multi.perform(on_finished, &shard).get_return_value();
+
+        const auto queued = shard.queued.load(std::memory_order_relaxed);
+        const auto handles = shard.multi.get_number_of_handles();
+
+        if (stop && handles == 0 && queued == 0)
+            break;
+
+        // Transfers finished in perform have made room for requests queued.
+        if (queued != 0 && (max_inflight == 0 || handles < max_inflight))
+            continue;
+
+        if (max_inflight != 0) {
+            if (queued != 0)
+                // Let an idle shard steal the requests that don't fit
+                wakeup_idle_shard();
+            else if (handles < max_inflight)
+                shard.idle.store(true, std::memory_order_relaxed);
+        }
+
+        shard.multi.poll(nullptr, 0, default_poll_timeout).get_return_value();
+        shard.idle.store(false, std::memory_order_relaxed);
+    }
+}
+void* Multi_runtime::shard_main(void *arg) noexcept
+{
+    auto &shard = *static_cast<Shard*>(arg);
+    shard.runtime->run(shard);
+    return nullptr;
+}
+
+void Multi_runtime::stop() noexcept
+{
+    if (!shards)
+        return;
+
+    stopping.store(true, std::memory_order_release);
+
+    for (std::size_t i = 0; i != shard_cnt; ++i) {
+        auto &shard = shards[i];
+        if (shard.started) {
+            shard.multi.wakeup();
+            pthread_join(shard.thread, nullptr);
+            shard.started = false;
+        }
+    }
+}
+
+Multi_runtime::~Multi_runtime()
+{
+    stop();
+}
+} /* namespace curl */
@@ -0,0 +1,256 @@
+#ifndef  __curl_cpp_curl_multi_runtime_HPP__
+# define __curl_cpp_curl_multi_runtime_HPP__
+
+# include "curl.hpp"
+# include "curl_easy.hpp"
+# include "curl_multi.hpp"
+# include "curl_share.hpp"
+# include "curl_host_router.hpp"
+# include "curl_submission_queue.hpp"
+
+# include <cstddef>
+# include <atomic>
+# include <memory>
+# include <mutex>
+# include <new>
+# include <string_view>
+# include <system_error>
+
+# include <pthread.h>
+
+namespace curl {
+/**
+ * @example curl_multi_runtime.cc
+ *
+ * Multi_runtime runs one Multi_t and event loop per thread, so that
+ * transfers can make use of multiple cores.
+ *
+ * Each thread (shard) has its own Multi_t, thus its own connection cache,
+ * and requests submitted are spread across shards round-robin.
+ * <br>DNS cache and TLS sessions can be shared among shards via set_share().
+ *
+ * The event loop of each shard uses Multi_t::poll, and requests are submitted
+ * via a Submission_queue, which wakes it up via Multi_t::wakeup.
+ *
+ * If set_max_inflight() is called, requests submitted to a shard are moved to its deque
+ * until they are added to its Multi_t, at most max_inflight at a time.
+ * <br>A shard that has room for more transfers but nothing queued steals half of
+ * the requests queued in the shard with the longest deque, and a shard left with
+ * requests queued wakes up an idle shard to do so.
+ * <br>Transfers already added to a Multi_t are never moved.
+ *
+ * To keep connections to a host in one connection cache, submit_to_host() routes
+ * requests by Host_router with bounded load, where load of a shard is the number of
+ * requests queued or in progress there.
+ * <br>Requests stolen by other shards don't benefit from this.
+ *
+ * Errors of the event loop, i.e. out of memory or bug in libcurl,
+ * are fatal.
+ *
+ * @pre curl_t::has_multi_poll_support() && curl_t::has_multi_wakeup_support()
+ */
+class Multi_runtime {
+public:
+    /**
+     * Called on the thread of the shard where the transfer is done.
+     *
+     * @param easy has been removed from the Multi_t of the shard, and
+     *             is owned by the callback.
+     *             <br>Easy_ref_t::get_private() can be used to retrieve
+     *             per-request data.
+     */
+    using completion_t = void (*)(Easy_t easy, Easy_ref_t::perform_ret_t ret, void *userp);
+
+    static constexpr const long default_poll_timeout = 1000;
+
+protected:
+    /**
+     * Max number of handles taken from a deque at once.
+     */
+    static constexpr const std::size_t batch_size = 64;
+
+    struct Shard {
+        Multi_runtime *runtime;
+        Multi_t multi;
+        pthread_t thread;
+        bool started = false;
+
+        Submission_queue inbox{multi};
+
+        std::mutex mutex;
+        /**
+         * Ring buffer of handles submitted but not yet added, protected by mutex.
+         * <br>The shard takes handles from the front and thieves from the back.
+         */
+        char **pending = nullptr;
+        std::size_t pending_head = 0;
+        std::size_t pending_cnt = 0;
+        std::size_t pending_capacity = 0;
+
+        /**
+         * Same as pending_cnt, but can be read without the lock
+         * to find a victim.
+         */
+        std::atomic<std::size_t> queued{0};
+        /**
+         * Number of requests queued or added to multi.
+         */
+        std::atomic<std::size_t> load{0};
+        /**
+         * True if the shard is polling with room for more transfers.
+         */
+        std::atomic<bool> idle{false};
+
+        /**
+         * Only accessed by the thread of the shard, handles taken from
+         * deques are copied here so that the lock is not held during Multi_t::add_easy.
+         */
+        char *batch[batch_size];
+
+        /**
+         * @return false if out of memory.
+         */
+        bool push_back(char *easy) noexcept;
+        auto pop_front(char **out, std::size_t n) noexcept -> std::size_t;
+        /**
+         * Take at most half of the handles queued.
+         */
+        auto steal(char **out, std::size_t n) noexcept -> std::size_t;
+
+        ~Shard();
+    };
+
+    curl_t &curl;
+
+    completion_t completion;
+    void *userp;
+
+    const std::size_t shard_cnt;
+    std::unique_ptr<Shard[]> shards;
+
+    Host_router router;
+    double load_factor = 1.25;
+
+    Share_base *share = nullptr;
+    long max_concurrent_stream = -1;
+    std::size_t max_inflight = 0;
+
+    std::atomic<std::size_t> next_shard{0};
+    std::atomic<bool> stopping{false};
+
+    static void* shard_main(void *arg) noexcept;
+    void run(Shard &shard) noexcept;
+    /**
+     * Add handles from the deque of shard, then from other shards,
+     * until there's no room for more transfers.
+     */
+    void fill(Shard &shard) noexcept;
+    auto find_victim(const Shard &thief) noexcept -> Shard*;
+    void wakeup_idle_shard() noexcept;
+
+public:
+    /**
+     * @param completion must not be nullptr.
+     * @param shards number of threads, 0 for the number of cpus available to this process.
+     */
+    Multi_runtime(curl_t &curl, completion_t completion, void *userp, std::size_t shards = 0) noexcept;
+
+    Multi_runtime(const Multi_runtime&) = delete;
+    Multi_runtime(Multi_runtime&&) = delete;
+
+    Multi_runtime& operator = (const Multi_runtime&) = delete;
+    Multi_runtime& operator = (Multi_runtime&&) = delete;
+
+    /**
+     * @param share would be attached to every handle submitted, it must be
+     *              thread-safe, e.g. Share<> with enable_multithreaded_share() called,
+     *              and outlive this runtime.
+     *              <br>Pass nullptr to disable sharing.
+     *
+     * Must be called before start().
+     */
+    void set_share(Share_base *share) noexcept;
+    /**
+     * Same as Multi_t::set_multiplexing, applied to every shard.
+     *
+     * Must be called before start().
+     */
+    void set_multiplexing(long max_concurrent_stream) noexcept;
+    /**
+     * @param max_inflight max number of transfers in the Multi_t of each shard,
+     *                     requests beyond that are queued and can be stolen by other shards.
+     *                     <br>0 means unlimited, which is the default, and disables
+     *                     work stealing.
+     *
+     * Must be called before start().
+     */
+    void set_max_inflight(std::size_t max_inflight) noexcept;
+    /**
+     * @param load_factor the load of a shard used by route() is bounded by
+     *                    load_factor * average load, must be > 1.
+     *                    <br>Lower value balances load better, while higher
+     *                    value keeps more hosts on their home shards.
+     *
+     * Must be called before start().
+     */
+    void set_load_factor(double load_factor) noexcept;
+
+    /**
+     * Create Multi_t and start the thread for every shard.
+     *
+     * @param pin_threads if true, thread of shard i is pinned to the ith cpu
+     *                    available to this process (wrapping around).
+     */
+    auto start(bool pin_threads = false) noexcept ->
+        Ret_except<void, std::bad_alloc, std::system_error, curl::Exception>;
+
+    auto get_number_of_shards() const noexcept -> std::size_t;
+
+    /**
+     * Thread-safe.
+     *
+     * @pre start() is called and stop() is not.
+     * @param easy must be fully configured. It is released on success.
+     *
+     * Submit to shards round-robin.
+     */
+    auto submit(Easy_t &easy) noexcept -> Ret_except<void, std::bad_alloc>;
+    /**
+     * Thread-safe.
+     *
+     * @param shard must be < get_number_of_shards().
+     *
+     * Submit to the specified shard.
+     */
+    auto submit(std::size_t shard, Easy_t &easy) noexcept -> Ret_except<void, std::bad_alloc>;
+
+    /**
+     * Thread-safe.
+     *
+     * @pre start() is called.
+     * @param host key for Host_router, e.g. from Host_router::get_authority().
+     * @return shard for requests to host.
+     */
+    auto route(std::string_view host) const noexcept -> std::size_t;
+    /**
+     * Thread-safe.
+     *
+     * Same as submit(route(host), easy).
+     */
+    auto submit_to_host(std::string_view host, Easy_t &easy) noexcept -> Ret_except<void, std::bad_alloc>;
+
+    /**
+     * Wait for all requests submitted to finish, then stop all threads.
+     *
+     * Requests must not be submitted concurrently with or after this call.
+     */
+    void stop() noexcept;
+
+    /**
+     * Calls stop().
+     */
+    ~Multi_runtime();
+};
+} /* namespace curl */
+
+#endif
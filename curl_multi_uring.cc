@@ -0,0 +1,481 @@
+#include "curl_multi_uring.hpp"
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <chrono>
+
+#include <poll.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+
+namespace curl {
+static int io_uring_setup(unsigned entries, struct io_uring_params *params) noexcept
+{
+#ifdef __NR_io_uring_setup
+    return syscall(__NR_io_uring_setup, entries, params);
+#else
+    errno = ENOSYS;
+    return -1;
+#endif
+}
+static int io_uring_enter(int fd, unsigned to_submit, unsigned min_complete, unsigned flags) noexcept
+{
+#ifdef __NR_io_uring_enter
+    return syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, nullptr, 0);
+#else
+    errno = ENOSYS;
+    return -1;
+#endif
+}
+
+/**
+ * user_data of sqe: tag in the top 2 bits, then fd and generation for poll requests,
+ * or generation for the timer.
+ */
+enum Tag: std::uint64_t {
+    poll_tag = 0,
+    timer_tag = 1,
+    ignored_tag = 2,
+};
+static constexpr auto make_user_data(Tag tag, int fd, std::uint32_t generation) noexcept -> std::uint64_t
+{
+    return (static_cast<std::uint64_t>(tag) << 62) | (static_cast<std::uint64_t>(fd) << 32) | generation;
+}
+
+bool Multi_uring_t::is_available() noexcept
+{
+    struct io_uring_params params = {};
+    int fd = io_uring_setup(1, &params);
+    if (fd == -1)
+        return false;
+    close(fd);
+    return true;
+}
+
+Multi_uring_t::Multi_uring_t(Multi_t &multi_arg, std::size_t max_events_arg, unsigned entries_arg) noexcept:
+    multi{multi_arg},
+    max_events{max_events_arg},
+    entries{entries_arg}
+{}
+
+static auto make_errno_error(const char *what) noexcept -> Ret_except<void, std::bad_alloc, std::system_error>
+{
+    if (errno == ENOMEM)
+        return {std::bad_alloc{}};
+    return {std::system_error{errno, std::generic_category(), what}};
+}
+auto Multi_uring_t::init() noexcept -> Ret_except<void, std::bad_alloc, std::system_error>
+{
+    events = static_cast<Event*>(std::malloc(max_events * sizeof(Event)));
+    if (!events)
+        return {std::bad_alloc{}};
+
+    struct io_uring_params params = {};
+    ring_fd = io_uring_setup(entries, &params);
+    if (ring_fd == -1)
+        return make_errno_error("In curl::Multi_uring_t::init: io_uring_setup failed");
+
+    sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+
+    const bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+    if (single_mmap)
+        sq_ring_size = cq_ring_size = std::max(sq_ring_size, cq_ring_size);
+
+    sq_ring = mmap(nullptr, sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                   ring_fd, IORING_OFF_SQ_RING);
+    if (sq_ring == MAP_FAILED) {
+        sq_ring = nullptr;
+        return make_errno_error("In curl::Multi_uring_t::init: mmap failed");
+    }
+
+    if (single_mmap)
+        cq_ring = sq_ring;
+    else {
+        cq_ring = mmap(nullptr, cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                       ring_fd, IORING_OFF_CQ_RING);
+        if (cq_ring == MAP_FAILED) {
+            cq_ring = nullptr;
+            return make_errno_error("In curl::Multi_uring_t::init: mmap failed");
+        }
+    }
+
+    sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+    void *addr = mmap(nullptr, sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                      ring_fd, IORING_OFF_SQES);
+    if (addr == MAP_FAILED)
+        return make_errno_error("In curl::Multi_uring_t::init: mmap failed");
+    sqes = static_cast<struct io_uring_sqe*>(addr);
+
+    auto *sq = static_cast<char*>(sq_ring);
+    sq_head = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+    sq_tail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+    sq_mask = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+    sq_entries = params.sq_entries;
+    sq_array = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+
+    auto *cq = static_cast<char*>(cq_ring);
+    cq_head = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+    cq_tail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+    cq_mask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+    cqes = reinterpret_cast<struct io_uring_cqe*>(cq + params.cq_off.cqes);
+
+#ifndef IORING_POLL_ADD_MULTI
+    multishot = false;
+#endif
+
+    multi.register_callback(socket_callback, this, timer_callback, this);
+
+    return {};
+}
+
+int Multi_uring_t::get_fd() const noexcept
+{
+    return ring_fd;
+}
+
+bool Multi_uring_t::update_interest(int fd, std::uint16_t interest) noexcept
+{
+    if (static_cast<std::size_t>(fd) >= sockets_size) {
+        if (interest == 0)
+            return true;
+
+        std::size_t new_size = sockets_size ? sockets_size : 64;
+        while (new_size <= static_cast<std::size_t>(fd))
+            new_size *= 2;
+
+        auto *p = static_cast<Socket*>(std::realloc(sockets, new_size * sizeof(Socket)));
+        if (!p)
+            return false;
+        std::fill(p + sockets_size, p + new_size, Socket{});
+        sockets = p;
+
+        // Each fd is queued at most once, so dirty_fds never needs to grow in reap().
+        auto *q = static_cast<int*>(std::realloc(dirty_fds, new_size * sizeof(int)));
+        if (!q)
+            return false;
+        dirty_fds = q;
+
+        sockets_size = new_size;
+    }
+
+    auto &socket = sockets[fd];
+    if (socket.interest == interest)
+        return true;
+
+    socket.interest = interest;
+    ++socket.generation;
+    mark_dirty(fd);
+
+    return true;
+}
+void Multi_uring_t::mark_dirty(int fd) noexcept
+{
+    auto &socket = sockets[fd];
+    if (!socket.dirty) {
+        socket.dirty = true;
+        dirty_fds[dirty_cnt++] = fd;
+    }
+}
+
+int Multi_uring_t::socket_callback(CURL *curl_easy, curl_socket_t s, int what, void *userp, void *per_socketp) noexcept
+{
+    std::uint16_t interest = 0;
+    switch (what) {
+        case CURL_POLL_IN:
+            interest = POLLIN;
+            break;
+
+        case CURL_POLL_OUT:
+            interest = POLLOUT;
+            break;
+
+        case CURL_POLL_INOUT:
+            interest = POLLIN | POLLOUT;
+            break;
+
+        case CURL_POLL_REMOVE:
+        default:
+            break;
+    }
+
+    return static_cast<Multi_uring_t*>(userp)->update_interest(s, interest) ? 0 : -1;
+}
+int Multi_uring_t::timer_callback(CURLM *curl_multi, long timeout_ms, void *userp) noexcept
+{
+    auto &uring = *static_cast<Multi_uring_t*>(userp);
+    uring.timeout_ms = timeout_ms;
+    uring.timer_dirty = true;
+    return 0;
+}
+
+int Multi_uring_t::enter(unsigned min_complete, unsigned flags) noexcept
+{
+    int ret = io_uring_enter(ring_fd, to_submit, min_complete, flags);
+    if (ret == -1)
+        return -errno;
+    to_submit -= ret;
+    return ret;
+}
+
+auto Multi_uring_t::get_sqe() noexcept -> struct io_uring_sqe*
+{
+    const unsigned tail = *sq_tail;
+    if (tail - __atomic_load_n(sq_head, __ATOMIC_ACQUIRE) == sq_entries) {
+        // Submission queue is full, submit the queued sqes first.
+        int ret = enter(0, 0);
+        if (ret < 0) {
+            errno = -ret;
+            return nullptr;
+        }
+        if (tail - __atomic_load_n(sq_head, __ATOMIC_ACQUIRE) == sq_entries) {
+            errno = EBUSY;
+            return nullptr;
+        }
+    }
+
+    const unsigned index = tail & sq_mask;
+    auto *sqe = &sqes[index];
+    std::memset(sqe, 0, sizeof(*sqe));
+    sq_array[index] = index;
+
+    // The kernel only consumes sqes in io_uring_enter, so the sqe can be
+    // filled after the tail is published.
+    __atomic_store_n(sq_tail, tail + 1, __ATOMIC_RELEASE);
+    ++to_submit;
+
+    return sqe;
+}
+
+bool Multi_uring_t::flush() noexcept
+{
+    for (; dirty_cnt != 0; --dirty_cnt) {
+        const int fd = dirty_fds[dirty_cnt - 1];
+        auto &socket = sockets[fd];
+
+        if (socket.armed) {
+            auto *sqe = get_sqe();
+            if (!sqe)
+                return false;
+            sqe->opcode = IORING_OP_POLL_REMOVE;
+            sqe->fd = -1;
+            sqe->addr = make_user_data(poll_tag, fd, socket.armed_generation);
+            sqe->user_data = make_user_data(ignored_tag, 0, 0);
+
+            socket.armed = 0;
+        }
+
+        if (socket.interest) {
+            auto *sqe = get_sqe();
+            if (!sqe)
+                return false;
+            sqe->opcode = IORING_OP_POLL_ADD;
+            sqe->fd = fd;
+            sqe->poll32_events = socket.interest;
+#ifdef IORING_POLL_ADD_MULTI
+            if (multishot)
+                sqe->len = IORING_POLL_ADD_MULTI;
+#endif
+            sqe->user_data = make_user_data(poll_tag, fd, socket.generation);
+
+            socket.armed = socket.interest;
+            socket.armed_generation = socket.generation;
+        }
+
+        socket.dirty = false;
+    }
+
+    if (timer_dirty) {
+        if (timer_armed) {
+            auto *sqe = get_sqe();
+            if (!sqe)
+                return false;
+            sqe->opcode = IORING_OP_TIMEOUT_REMOVE;
+            sqe->fd = -1;
+            sqe->addr = make_user_data(timer_tag, 0, timer_generation);
+            sqe->user_data = make_user_data(ignored_tag, 0, 0);
+
+            timer_armed = false;
+        }
+
+        ++timer_generation;
+
+        if (timeout_ms >= 0) {
+            auto *sqe = get_sqe();
+            if (!sqe)
+                return false;
+
+            timer_ts.tv_sec = timeout_ms / 1000;
+            timer_ts.tv_nsec = (timeout_ms % 1000) * 1000000;
+
+            sqe->opcode = IORING_OP_TIMEOUT;
+            sqe->fd = -1;
+            sqe->addr = reinterpret_cast<std::uintptr_t>(&timer_ts);
+            sqe->len = 1;
+            sqe->user_data = make_user_data(timer_tag, 0, timer_generation);
+
+            timer_armed = true;
+        }
+
+        timer_dirty = false;
+    }
+
+    return true;
+}
+
+void Multi_uring_t::handle_cqe(const struct io_uring_cqe &cqe) noexcept
+{
+    const auto tag = static_cast<Tag>(cqe.user_data >> 62);
+    const auto generation = static_cast<std::uint32_t>(cqe.user_data);
+
+    if (tag == timer_tag) {
+        // Timeouts removed or replaced are ignored.
+        if (generation != timer_generation || !timer_armed)
+            return;
+        timer_armed = false;
+        if (cqe.res == -ETIME)
+            events[event_cnt++] = Event{CURL_SOCKET_TIMEOUT, 0, 0};
+        return;
+    }
+    if (tag != poll_tag)
+        return;
+
+    const int fd = (cqe.user_data >> 32) & 0x3fffffff;
+    auto &socket = sockets[fd];
+
+    // Completions of poll requests that have been removed are ignored.
+    if (!socket.armed || socket.armed_generation != generation)
+        return;
+
+#ifdef IORING_CQE_F_MORE
+    const bool more = cqe.flags & IORING_CQE_F_MORE;
+#else
+    const bool more = false;
+#endif
+    if (!more) {
+        // The poll request is terminated, re-arm it on next flush().
+        socket.armed = 0;
+        if (cqe.res == -EINVAL && multishot) {
+            // Kernel before 5.13 rejects multishot poll.
+            multishot = false;
+            mark_dirty(fd);
+            return;
+        }
+        if (socket.interest)
+            mark_dirty(fd);
+    }
+
+    // Interest has been changed since the poll request is armed.
+    if (socket.generation != generation || cqe.res == -ECANCELED)
+        return;
+
+    int ev_bitmask = 0;
+    if (cqe.res < 0)
+        ev_bitmask = CURL_CSELECT_ERR;
+    else {
+        if (cqe.res & POLLIN)
+            ev_bitmask |= CURL_CSELECT_IN;
+        if (cqe.res & POLLOUT)
+            ev_bitmask |= CURL_CSELECT_OUT;
+        if (cqe.res & (POLLERR | POLLHUP))
+            ev_bitmask |= CURL_CSELECT_ERR;
+    }
+
+    events[event_cnt++] = Event{fd, ev_bitmask, generation};
+}
+void Multi_uring_t::reap() noexcept
+{
+    unsigned head = *cq_head;
+    const unsigned tail = __atomic_load_n(cq_tail, __ATOMIC_ACQUIRE);
+
+    for (; head != tail && event_cnt != max_events; ++head)
+        handle_cqe(cqes[head & cq_mask]);
+
+    __atomic_store_n(cq_head, head, __ATOMIC_RELEASE);
+}
+
+auto Multi_uring_t::wait(int timeout) noexcept -> Ret_except<std::size_t, std::bad_alloc, std::system_error>
+{
+    using clock = std::chrono::steady_clock;
+
+    event_cnt = 0;
+
+    auto deadline = clock::now() + std::chrono::milliseconds{timeout > 0 ? timeout : 0};
+
+    // Completions of the requests below, of POLL_REMOVE/TIMEOUT_REMOVE and of stale sockets
+    // are reaped without producing any event, so keep waiting until the deadline.
+    for (;;) {
+        if (!flush())
+            return {std::system_error{errno, std::generic_category(), "In curl::Multi_uring_t::wait: submission failed"}};
+
+        unsigned min_complete = 0;
+        if (timeout != 0 && *cq_head == __atomic_load_n(cq_tail, __ATOMIC_ACQUIRE)) {
+            min_complete = 1;
+
+            if (timeout > 0) {
+                auto remaining = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - clock::now());
+                if (remaining.count() <= 0)
+                    break;
+
+                auto *sqe = get_sqe();
+                if (!sqe)
+                    return {std::system_error{errno, std::generic_category(), "In curl::Multi_uring_t::wait: submission failed"}};
+
+                wait_ts.tv_sec = remaining.count() / 1000000000;
+                wait_ts.tv_nsec = remaining.count() % 1000000000;
+
+                // Completes after either any other completion or timeout.
+                sqe->opcode = IORING_OP_TIMEOUT;
+                sqe->fd = -1;
+                sqe->addr = reinterpret_cast<std::uintptr_t>(&wait_ts);
+                sqe->len = 1;
+                sqe->off = 1;
+                sqe->user_data = make_user_data(ignored_tag, 0, 0);
+            }
+        }
+
+        bool interrupted = false;
+        if (to_submit != 0 || min_complete != 0) {
+            int ret = enter(min_complete, min_complete ? IORING_ENTER_GETEVENTS : 0);
+            // EBUSY and EAGAIN mean that the completion queue needs to be reaped first.
+            if (ret < 0 && ret != -EINTR && ret != -EBUSY && ret != -EAGAIN) {
+                if (ret == -ENOMEM)
+                    return {std::bad_alloc{}};
+                return {std::system_error{-ret, std::generic_category(), "In curl::Multi_uring_t::wait: io_uring_enter failed"}};
+            }
+            interrupted = ret == -EINTR;
+        }
+
+        reap();
+
+        if (event_cnt != 0 || timeout == 0 || interrupted)
+            break;
+    }
+
+    return {event_cnt};
+}
+
+Multi_uring_t::~Multi_uring_t()
+{
+    if (ring_fd != -1) {
+        if (sqes)
+            multi.register_callback(nullptr, nullptr, nullptr, nullptr);
+        close(ring_fd);
+    }
+
+    if (sqes)
+        munmap(sqes, sqes_size);
+    if (cq_ring && cq_ring != sq_ring)
+        munmap(cq_ring, cq_ring_size);
+    if (sq_ring)
+        munmap(sq_ring, sq_ring_size);
+
+    std::free(dirty_fds);
+    std::free(sockets);
+    std::free(events);
+}
+} /* namespace curl */
@@ -0,0 +1,259 @@
+#ifndef  __curl_cpp_curl_multi_uring_HPP__
+# define __curl_cpp_curl_multi_uring_HPP__
+
+# include "curl_multi.hpp"
+
+# include <cstddef>
+# include <cstdint>
+# include <new>
+# include <utility>
+# include <system_error>
+
+# include <linux/time_types.h>
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+namespace curl {
+/**
+ * @example curl_multi_uring.cc
+ *
+ * Multi_uring_t drives Multi_t's multi_socket_action interface with io_uring,
+ * as a drop-in alternative to Multi_epoll_t:
+ *  - readiness of each socket is watched by a multishot IORING_OP_POLL_ADD,
+ *    which is armed once and keeps posting completions until the interest
+ *    changes;
+ *  - the timeout requested by libcurl is an IORING_OP_TIMEOUT;
+ *  - changes requested by libcurl are only recorded in the callbacks, then
+ *    submitted together with waiting for completions in a single io_uring_enter
+ *    in wait().
+ *
+ * Usage is the same as Multi_epoll_t:
+ *
+ *     if (!curl::Multi_uring_t::is_available())
+ *         // use Multi_epoll_t instead
+ *     uring.init().get_return_value();
+ *     uring.start(perform_callback, arg);
+ *     while (multi.get_number_of_handles()) {
+ *         uring.wait(-1).get_return_value();
+ *         uring.perform(perform_callback, arg);
+ *     }
+ *
+ * On kernels that reject multishot poll (before 5.13), Multi_uring_t
+ * falls back to re-arming a oneshot poll after each completion.
+ *
+ * @pre curl_t::has_multi_socket_support()
+ *
+ * Multi_uring_t must not be moved after init(), and Multi_t must not be used with
+ * any other polling interface.
+ */
+class Multi_uring_t {
+protected:
+    struct Socket {
+        /**
+         * Poll mask requested by libcurl, 0 if not registered.
+         */
+        std::uint16_t interest = 0;
+        /**
+         * Poll mask of the poll request in the kernel, 0 if none.
+         */
+        std::uint16_t armed = 0;
+        /**
+         * Incremented whenever interest changes, so that completions
+         * of poll requests that have been removed are ignored.
+         */
+        std::uint32_t generation = 0;
+        /**
+         * Generation when the poll request in the kernel is armed.
+         */
+        std::uint32_t armed_generation = 0;
+        bool dirty = false;
+    };
+
+    struct Event {
+        curl_socket_t socketfd;
+        int ev_bitmask;
+        std::uint32_t generation;
+    };
+
+    Multi_t &multi;
+
+    int ring_fd = -1;
+
+    void *sq_ring = nullptr;
+    std::size_t sq_ring_size = 0;
+    void *cq_ring = nullptr;
+    std::size_t cq_ring_size = 0;
+    struct io_uring_sqe *sqes = nullptr;
+    std::size_t sqes_size = 0;
+
+    unsigned *sq_head;
+    unsigned *sq_tail;
+    unsigned sq_mask;
+    unsigned sq_entries;
+    unsigned *sq_array;
+    unsigned *cq_head;
+    unsigned *cq_tail;
+    unsigned cq_mask;
+    struct io_uring_cqe *cqes;
+
+    /**
+     * Number of sqes queued but not yet submitted.
+     */
+    unsigned to_submit = 0;
+
+    Socket *sockets = nullptr;
+    std::size_t sockets_size = 0;
+
+    /**
+     * fds whose interest differs from the poll request in the kernel.
+     */
+    int *dirty_fds = nullptr;
+    std::size_t dirty_cnt = 0;
+
+    /**
+     * Timeout requested by libcurl, -1 if disarmed.
+     */
+    long timeout_ms = -1;
+    bool timer_dirty = false;
+    bool timer_armed = false;
+    std::uint32_t timer_generation = 0;
+    struct __kernel_timespec timer_ts;
+    struct __kernel_timespec wait_ts;
+
+    bool multishot = true;
+
+    Event *events = nullptr;
+    const std::size_t max_events;
+    const unsigned entries;
+    std::size_t event_cnt = 0;
+
+    static int socket_callback(CURL *curl_easy, curl_socket_t s, int what, void *userp, void *per_socketp) noexcept;
+    static int timer_callback(CURLM *curl_multi, long timeout_ms, void *userp) noexcept;
+
+    /**
+     * @return false on error.
+     */
+    bool update_interest(int fd, std::uint16_t interest) noexcept;
+    void mark_dirty(int fd) noexcept;
+
+    /**
+     * Submit queued sqes first if the submission queue is full.
+     *
+     * @return nullptr on error, with errno set.
+     */
+    auto get_sqe() noexcept -> struct io_uring_sqe*;
+    /**
+     * Queue sqes for all changes requested by libcurl since the last call.
+     *
+     * @return false on error, with errno set.
+     */
+    bool flush() noexcept;
+
+    /**
+     * @return -errno on error.
+     */
+    int enter(unsigned min_complete, unsigned flags) noexcept;
+    void reap() noexcept;
+    void handle_cqe(const struct io_uring_cqe &cqe) noexcept;
+
+public:
+    /**
+     * @return false if the kernel lacks io_uring or it is disabled,
+     *         in which case Multi_epoll_t should be used instead.
+     */
+    static bool is_available() noexcept;
+
+    /**
+     * @param max_events max number of events retrieved by one wait().
+     * @param entries size of submission queue, rounded up to power of 2 by the kernel.
+     *                <br>More sqes than entries can be queued before wait(),
+     *                at the cost of extra io_uring_enter.
+     */
+    Multi_uring_t(Multi_t &multi, std::size_t max_events = 64, unsigned entries = 256) noexcept;
+
+    Multi_uring_t(const Multi_uring_t&) = delete;
+    Multi_uring_t(Multi_uring_t&&) = delete;
+
+    Multi_uring_t& operator = (const Multi_uring_t&) = delete;
+    Multi_uring_t& operator = (Multi_uring_t&&) = delete;
+
+    /**
+     * Create io_uring and register callbacks to multi.
+     *
+     * Must be called before any easy handle is added to multi.
+     *
+     * If the kernel lacks io_uring, std::system_error with ENOSYS is returned.
+     */
+    auto init() noexcept -> Ret_except<void, std::bad_alloc, std::system_error>;
+
+    /**
+     * @return fd of io_uring, which can be polled by another event loop
+     *         for completions.
+     */
+    int get_fd() const noexcept;
+
+    /**
+     * Start the transfer, must be called after easy handles are added.
+     *
+     * @param perform_callback, arg same as Multi_t::multi_socket_action.
+     */
+    template <class perform_callback_t, class T>
+    auto start(perform_callback_t &&perform_callback, T &&arg) noexcept -> Multi_t::perform_ret_t
+    {
+        return multi.multi_socket_action(CURL_SOCKET_TIMEOUT, 0,
+                                         std::forward<perform_callback_t>(perform_callback),
+                                         std::forward<T>(arg));
+    }
+
+    /**
+     * Submit pending changes and wait for completions.
+     *
+     * @param timeout in ms, -1 means infinite.
+     * @return number of events retrieved, 0 if timeout or interrupted by signal.
+     *
+     * Completions that carry no event (e.g. of sockets already removed) don't
+     * end the wait early, it keeps waiting until the deadline.
+     */
+    auto wait(int timeout = -1) noexcept -> Ret_except<std::size_t, std::bad_alloc, std::system_error>;
+
+    /**
+     * Process events retrieved by the last wait().
+     *
+     * @param perform_callback, arg same as Multi_t::multi_socket_action.
+     * @return same as the last call to Multi_t::multi_socket_action, or 0 if there's no event
+     *         or the last event is skipped.
+     *         <br>If an exception is returned, events left unprocessed are discarded.
+     */
+    template <class perform_callback_t, class T>
+    auto perform(perform_callback_t &&perform_callback, T &&arg) noexcept -> Multi_t::perform_ret_t
+    {
+        for (std::size_t i = 0; i != event_cnt; ++i) {
+            const auto &event = events[i];
+
+            // Skip events of sockets that are removed or changed by previous events.
+            if (event.socketfd != CURL_SOCKET_TIMEOUT &&
+                sockets[event.socketfd].generation != event.generation)
+                continue;
+
+            auto ret = multi.multi_socket_action(event.socketfd, event.ev_bitmask, perform_callback, arg);
+            if (ret.has_exception_set() || i + 1 == event_cnt) {
+                event_cnt = 0;
+                return ret;
+            }
+        }
+        event_cnt = 0;
+        return {0};
+    }
+
+    /**
+     * Unregister callbacks from multi and close io_uring, which cancels
+     * all requests in the kernel.
+     *
+     * @pre multi.get_number_of_handles() == 0
+     */
+    ~Multi_uring_t();
+};
+} /* namespace curl */
+
+#endif
@@ -0,0 +1,32 @@
+#include "curl_options.hpp"
+
+namespace curl {
+static auto apply_option(Easy_ref_t &easy, const Easy_option &option) noexcept -> CURLcode
+{
+    if (option.type == Easy_option::Type::integer)
+        return curl_easy_setopt(easy.curl_easy, option.id, option.integer);
+    else
+        return curl_easy_setopt(easy.curl_easy, option.id, option.string);
+}
+
+auto Option_set_base::apply_impl(Easy_ref_t &easy, const Easy_option *options, std::size_t n) noexcept ->
+    Ret_except<void, std::bad_alloc>
+{
+    for (std::size_t i = 0; i != n; ++i)
+        if (apply_option(easy, options[i]) == CURLE_OUT_OF_MEMORY)
+            return {std::bad_alloc{}};
+    return {};
+}
+auto Option_set_base::apply_changed_impl(Easy_ref_t &easy, const Easy_option *options, std::size_t n,
+                                         const Easy_option *prev, std::size_t prev_n) noexcept ->
+    Ret_except<void, std::bad_alloc>
+{
+    for (std::size_t i = 0; i != n; ++i) {
+        if (!is_changed_impl(options, n, i, prev, prev_n))
+            continue;
+        if (apply_option(easy, options[i]) == CURLE_OUT_OF_MEMORY)
+            return {std::bad_alloc{}};
+    }
+    return {};
+}
+} /* namespace curl */
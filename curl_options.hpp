@@ -0,0 +1,275 @@
+#ifndef  __curl_cpp_curl_options_HPP__
+# define __curl_cpp_curl_options_HPP__
+
+# include "curl.hpp"
+# include "curl_easy.hpp"
+
+# include <cstddef>
+# include <cstdint>
+# include <new>
+
+# include <curl/curl.h>
+
+namespace curl {
+/**
+ * A single option of Easy_ref_t, created via functions in namespace curl::options.
+ */
+struct Easy_option {
+    enum class Type: unsigned char {
+        integer,
+        string,
+    };
+
+    CURLoption id;
+    Type type;
+    long integer;
+    /**
+     * The string is copied by libcurl when applied.
+     */
+    const char *string;
+    /**
+     * Minimal version of libcurl that supports this option,
+     * in the same format as curl_t::Version::num.
+     */
+    std::uint32_t min_version;
+
+    /**
+     * @return true if x and y would set the same value to the same option.
+     *
+     * Strings are compared by address, so options set from the same
+     * constant string are equal.
+     */
+    friend constexpr bool operator == (const Easy_option &x, const Easy_option &y) noexcept
+    {
+        if (x.id != y.id || x.type != y.type)
+            return false;
+        if (x.type == Type::integer)
+            return x.integer == y.integer;
+        return x.string == y.string;
+    }
+    friend constexpr bool operator != (const Easy_option &x, const Easy_option &y) noexcept
+    {
+        return !(x == y);
+    }
+};
+
+namespace options {
+constexpr auto integer_option(CURLoption id, long value, curl_t::Version min_version) noexcept -> Easy_option
+{
+    return {id, Easy_option::Type::integer, value, nullptr, min_version.num};
+}
+constexpr auto string_option(CURLoption id, const char *value, curl_t::Version min_version) noexcept -> Easy_option
+{
+    return {id, Easy_option::Type::string, 0, value, min_version.num};
+}
+
+/**
+ * Same as Easy_ref_t::set_url.
+ */
+constexpr auto url(const char *value) noexcept
+{
+    return string_option(CURLOPT_URL, value, curl_t::Version::from(7, 1, 0));
+}
+/**
+ * Same as Easy_ref_t::set_useragent.
+ */
+constexpr auto useragent(const char *value) noexcept
+{
+    return string_option(CURLOPT_USERAGENT, value, curl_t::Version::from(7, 1, 0));
+}
+/**
+ * Same as Easy_ref_t::set_encoding.
+ */
+constexpr auto encoding(const char *value) noexcept
+{
+    return string_option(CURLOPT_ACCEPT_ENCODING, value, curl_t::Version::from(7, 21, 6));
+}
+/**
+ * Same as Easy_ref_t::set_interface.
+ */
+constexpr auto interface(const char *value) noexcept
+{
+    return string_option(CURLOPT_INTERFACE, value, curl_t::Version::from(7, 3, 0));
+}
+
+/**
+ * Same as Easy_ref_t::set_timeout.
+ */
+constexpr auto timeout(unsigned long ms) noexcept
+{
+    return integer_option(CURLOPT_TIMEOUT_MS, ms, curl_t::Version::from(7, 16, 2));
+}
+constexpr auto connect_timeout(unsigned long ms) noexcept
+{
+    return integer_option(CURLOPT_CONNECTTIMEOUT_MS, ms, curl_t::Version::from(7, 16, 2));
+}
+/**
+ * Abort the transfer if it is slower than bytes_per_sec for seconds.
+ */
+constexpr auto low_speed_limit(long bytes_per_sec) noexcept
+{
+    return integer_option(CURLOPT_LOW_SPEED_LIMIT, bytes_per_sec, curl_t::Version::from(7, 1, 0));
+}
+constexpr auto low_speed_time(long seconds) noexcept
+{
+    return integer_option(CURLOPT_LOW_SPEED_TIME, seconds, curl_t::Version::from(7, 1, 0));
+}
+
+constexpr auto follow_location(bool enable) noexcept
+{
+    return integer_option(CURLOPT_FOLLOWLOCATION, enable, curl_t::Version::from(7, 1, 0));
+}
+constexpr auto max_redirs(long redir) noexcept
+{
+    return integer_option(CURLOPT_MAXREDIRS, redir, curl_t::Version::from(7, 5, 0));
+}
+
+/**
+ * Same as Easy_ref_t::set_nobody.
+ */
+constexpr auto nobody(bool enable) noexcept
+{
+    return integer_option(CURLOPT_NOBODY, enable, curl_t::Version::from(7, 1, 0));
+}
+
+constexpr auto tcp_keepalive(bool enable) noexcept
+{
+    return integer_option(CURLOPT_TCP_KEEPALIVE, enable, curl_t::Version::from(7, 25, 0));
+}
+constexpr auto tcp_nodelay(bool enable) noexcept
+{
+    return integer_option(CURLOPT_TCP_NODELAY, enable, curl_t::Version::from(7, 11, 2));
+}
+
+/**
+ * @param version one of CURL_HTTP_VERSION_*
+ */
+constexpr auto http_version(long version) noexcept
+{
+    return integer_option(CURLOPT_HTTP_VERSION, version, curl_t::Version::from(7, 9, 1));
+}
+} /* namespace options */
+
+class Option_set_base {
+protected:
+    static auto apply_impl(Easy_ref_t &easy, const Easy_option *options, std::size_t n) noexcept ->
+        Ret_except<void, std::bad_alloc>;
+    static auto apply_changed_impl(Easy_ref_t &easy, const Easy_option *options, std::size_t n,
+                                   const Easy_option *prev, std::size_t prev_n) noexcept ->
+        Ret_except<void, std::bad_alloc>;
+
+    static constexpr bool is_changed_impl(const Easy_option *options, std::size_t n, std::size_t i,
+                                          const Easy_option *prev, std::size_t prev_n) noexcept
+    {
+        const auto &option = options[i];
+
+        // If the option appears more than once, apply all of them in order
+        // so that the last one wins.
+        for (std::size_t j = 0; j != n; ++j)
+            if (j != i && options[j].id == option.id)
+                return true;
+
+        // Only the last one in prev takes effect.
+        for (std::size_t j = prev_n; j != 0; --j)
+            if (prev[j - 1].id == option.id)
+                return prev[j - 1] != option;
+        return true;
+    }
+};
+
+/**
+ * @example curl_options.cc
+ *
+ * Option_set describes a profile of a request at compile time, e.g.
+ *
+ *     constexpr auto profile = curl::make_option_set(
+ *         curl::options::useragent("curl-cpp"),
+ *         curl::options::encoding(""),
+ *         curl::options::timeout(3000)
+ *     );
+ *     static_assert(profile.get_min_version() <= LIBCURL_VERSION_NUM);
+ *
+ * and applies it to Easy_ref_t in one loop.
+ *
+ * If an option appears more than once, the last one wins.
+ */
+template <std::size_t N>
+class Option_set: public Option_set_base {
+public:
+    Easy_option options[N];
+
+    static constexpr auto size() noexcept -> std::size_t
+    {
+        return N;
+    }
+
+    /**
+     * @return the minimal version of libcurl that supports all options,
+     *         in the same format as curl_t::Version::num and LIBCURL_VERSION_NUM.
+     */
+    constexpr auto get_min_version() const noexcept -> std::uint32_t
+    {
+        std::uint32_t version = 0;
+        for (const auto &option: options)
+            if (option.min_version > version)
+                version = option.min_version;
+        return version;
+    }
+    bool is_supported(const curl_t &curl) const noexcept
+    {
+        return curl.version.num >= get_min_version();
+    }
+
+    /**
+     * @return true if options[i] would change the handle
+     *         after prev is applied to it.
+     *
+     * An option that appears more than once in this set is always considered changed.
+     */
+    template <std::size_t M>
+    constexpr bool is_changed(std::size_t i, const Option_set<M> &prev) const noexcept
+    {
+        return is_changed_impl(options, N, i, prev.options, M);
+    }
+    /**
+     * @return number of options that would change the handle
+     *         after prev is applied to it.
+     */
+    template <std::size_t M>
+    constexpr auto count_changed(const Option_set<M> &prev) const noexcept -> std::size_t
+    {
+        std::size_t cnt = 0;
+        for (std::size_t i = 0; i != N; ++i)
+            cnt += is_changed(i, prev);
+        return cnt;
+    }
+
+    /**
+     * @pre is_supported(curl)
+     */
+    auto apply(Easy_ref_t &easy) const noexcept -> Ret_except<void, std::bad_alloc>
+    {
+        return apply_impl(easy, options, N);
+    }
+    /**
+     * @pre is_supported(curl) and prev is the last Option_set applied to easy.
+     *
+     * Only apply options that are changed.
+     * <br>Options that are in prev but not in this set are not reset.
+     */
+    template <std::size_t M>
+    auto apply_changed(Easy_ref_t &easy, const Option_set<M> &prev) const noexcept ->
+        Ret_except<void, std::bad_alloc>
+    {
+        return apply_changed_impl(easy, options, N, prev.options, M);
+    }
+};
+
+template <class ...Options>
+constexpr auto make_option_set(Options ...options) noexcept -> Option_set<sizeof...(Options)>
+{
+    return {{}, {options...}};
+}
+} /* namespace curl */
+
+#endif
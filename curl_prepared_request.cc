@@ -0,0 +1,117 @@
+#include "curl_prepared_request.hpp"
+
+#include <chrono>
+#include <utility>
+
+namespace curl {
+Prepared_request::Prepared_request(curl_t &curl_arg, configure_t configure_arg, void *userp_arg,
+                                   Strategy strategy_arg, std::size_t buffer_size_arg) noexcept:
+    curl{curl_arg},
+    configure{configure_arg},
+    userp{userp_arg},
+    buffer_size{buffer_size_arg},
+    strategy{strategy_arg}
+{}
+
+void Prepared_request::set_headers(utils::header_set headers_arg) noexcept
+{
+    headers = std::move(headers_arg);
+}
+
+void Prepared_request::replay(Easy_ref_t &easy) const noexcept
+{
+    configure(easy, userp);
+    if (!headers.is_empty())
+        easy.set_http_header(headers);
+}
+
+void Prepared_request::select_strategy() noexcept
+{
+    using clock = std::chrono::steady_clock;
+    constexpr const auto rounds = 16;
+
+    auto start = clock::now();
+    for (auto i = 0; i != rounds; ++i)
+        curl.dup_easy(prototype, buffer_size);
+    auto dup_time = clock::now() - start;
+
+    start = clock::now();
+    for (auto i = 0; i != rounds; ++i) {
+        auto easy = curl.create_easy(buffer_size);
+        if (easy) {
+            Easy_ref_t easy_ref{easy.get()};
+            replay(easy_ref);
+        }
+    }
+    auto replay_time = clock::now() - start;
+
+    strategy = dup_time <= replay_time ? Strategy::dup : Strategy::replay;
+}
+
+auto Prepared_request::prepare() noexcept -> Ret_except<void, std::bad_alloc>
+{
+    prototype = curl.create_easy(buffer_size);
+    if (!prototype)
+        return {std::bad_alloc{}};
+
+    Easy_ref_t easy_ref{prototype.get()};
+    replay(easy_ref);
+
+    if (strategy == Strategy::automatic)
+        select_strategy();
+
+    return {};
+}
+
+auto Prepared_request::get_strategy() const noexcept -> Strategy
+{
+    return strategy;
+}
+
+bool Prepared_request::patch(Easy_ref_t &easy, const char *url, const void *body, std::size_t len) noexcept
+{
+    bool oom = false;
+    easy.set_url(url).Catch([&](std::bad_alloc) noexcept { oom = true; });
+    if (oom)
+        return false;
+
+    if (body)
+        easy.request_post(body, len);
+    return true;
+}
+
+auto Prepared_request::instantiate(const char *url, const void *body, std::size_t len) noexcept ->
+    Ret_except<Easy_t, std::bad_alloc>
+{
+    Easy_t easy;
+    if (strategy == Strategy::dup)
+        easy = curl.dup_easy(prototype, buffer_size);
+    else
+        easy = curl.create_easy(buffer_size);
+
+    if (!easy)
+        return {std::bad_alloc{}};
+
+    Easy_ref_t easy_ref{easy.get()};
+    if (strategy != Strategy::dup)
+        replay(easy_ref);
+
+    if (!patch(easy_ref, url, body, len))
+        return {std::bad_alloc{}};
+
+    return {std::move(easy)};
+}
+
+auto Prepared_request::reinstantiate(const Easy_t &easy, const char *url, const void *body,
+                                     std::size_t len) noexcept -> Ret_except<void, std::bad_alloc>
+{
+    curl.reset_easy(easy, buffer_size);
+
+    Easy_ref_t easy_ref{easy.get()};
+    replay(easy_ref);
+
+    if (!patch(easy_ref, url, body, len))
+        return {std::bad_alloc{}};
+    return {};
+}
+} /* namespace curl */
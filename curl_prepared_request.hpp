@@ -0,0 +1,125 @@
+#ifndef  __curl_cpp_curl_prepared_request_HPP__
+# define __curl_cpp_curl_prepared_request_HPP__
+
+# include "curl.hpp"
+# include "curl_easy.hpp"
+# include "utils/header_set.hpp"
+
+# include <cstddef>
+# include <new>
+
+namespace curl {
+/**
+ * @example curl_prepared_request.cc
+ *
+ * Prepared_request configures an easy handle once and then produces
+ * ready-to-use handles that only differ in url and request body.
+ *
+ * Handles are produced by either:
+ *  - Strategy::dup: curl_t::dup_easy() on the configured prototype, which copies
+ *    all options in one call;
+ *  - Strategy::replay: curl_t::create_easy() or curl_t::reset_easy(), then call configure again;
+ *  - Strategy::automatic: measure both strategies in prepare() and use the faster one.
+ *
+ * Since libcurl copies every string option except CURLOPT_POSTFIELDS and lists,
+ * the only storage shared by the handles produced are the headers, which
+ * are owned by Prepared_request.
+ * <br>Thus Prepared_request must outlive all handles it produces, and
+ * data passed to Easy_ref_t::request_post in configure must be kept around
+ * until they are destroyed.
+ *
+ * Prepared_request itself is not thread-safe.
+ */
+class Prepared_request {
+public:
+    enum class Strategy {
+        dup,
+        replay,
+        automatic,
+    };
+
+    /**
+     * Set every option common to all requests on easy, e.g. timeouts, TLS settings,
+     * encoding and callbacks.
+     *
+     * Headers should be set via set_headers() instead.
+     */
+    using configure_t = void (*)(Easy_ref_t &easy, void *userp);
+
+protected:
+    curl_t &curl;
+
+    configure_t configure;
+    void *userp;
+
+    const std::size_t buffer_size;
+    Strategy strategy;
+
+    utils::header_set headers;
+    Easy_t prototype;
+
+    void replay(Easy_ref_t &easy) const noexcept;
+    void select_strategy() noexcept;
+
+    /**
+     * @return false if out of memory.
+     */
+    static bool patch(Easy_ref_t &easy, const char *url, const void *body, std::size_t len) noexcept;
+
+public:
+    /**
+     * @param configure must not be nullptr.
+     * @param buffer_size passed to curl_t::create_easy, curl_t::dup_easy and curl_t::reset_easy.
+     */
+    Prepared_request(curl_t &curl, configure_t configure, void *userp,
+                     Strategy strategy = Strategy::automatic, std::size_t buffer_size = 0) noexcept;
+
+    Prepared_request(const Prepared_request&) = delete;
+    Prepared_request(Prepared_request&&) = delete;
+
+    Prepared_request& operator = (const Prepared_request&) = delete;
+    Prepared_request& operator = (Prepared_request&&) = delete;
+
+    /**
+     * @param headers would be sent with every request.
+     *
+     * Must be called before prepare().
+     */
+    void set_headers(utils::header_set headers) noexcept;
+
+    /**
+     * Create the prototype handle, and select strategy if Strategy::automatic is used.
+     */
+    auto prepare() noexcept -> Ret_except<void, std::bad_alloc>;
+
+    /**
+     * @return Strategy::dup or Strategy::replay after prepare().
+     */
+    auto get_strategy() const noexcept -> Strategy;
+
+    /**
+     * @pre prepare() is called.
+     * @param url would be copied.
+     * @param body if not nullptr, the request would be POST with body, which is not copied,
+     *             see Easy_ref_t::request_post.
+     *
+     * Create a new handle.
+     */
+    auto instantiate(const char *url, const void *body = nullptr, std::size_t len = 0) noexcept ->
+        Ret_except<Easy_t, std::bad_alloc>;
+
+    /**
+     * @pre prepare() is called.
+     * @param easy must not be nullptr, would be curl_t::reset_easy() and configured,
+     *             so that its connections and caches are reused.
+     *             <br>It must not be in a Multi_t.
+     * @param url, body, len same as instantiate.
+     *
+     * Reuse an existing handle, e.g. from Easy_pool.
+     */
+    auto reinstantiate(const Easy_t &easy, const char *url, const void *body = nullptr, 
+                       std::size_t len = 0) noexcept -> Ret_except<void, std::bad_alloc>;
+};
+} /* namespace curl */
+
+#endif
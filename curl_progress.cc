@@ -0,0 +1,112 @@
+#include "curl_progress.hpp"
+
+namespace curl {
+Progress_sampler::Progress_sampler(std::chrono::milliseconds interval_arg, std::size_t min_bytes_arg,
+                                   double smoothing_arg) noexcept:
+    interval{interval_arg},
+    min_bytes{min_bytes_arg},
+    smoothing{smoothing_arg}
+{}
+
+void Progress_sampler::set_callback(callback_t callback_arg, void *userp_arg) noexcept
+{
+    callback = callback_arg;
+    userp = userp_arg;
+}
+
+void Progress_sampler::attach(Easy_ref_t &easy) noexcept
+{
+    curl_easy = easy.curl_easy;
+
+    start_time = clock::now();
+    last_time = start_time;
+    last_transfered = 0;
+
+    sample = Sample{};
+    has_rate = false;
+
+    easy.set_xferinfo(xferinfo, this);
+}
+void Progress_sampler::detach(Easy_ref_t &easy) noexcept
+{
+    easy.set_xferinfo(nullptr, nullptr);
+    curl_easy = nullptr;
+}
+
+auto Progress_sampler::get_sample() const noexcept -> const Sample&
+{
+    return sample;
+}
+
+bool Progress_sampler::update(std::size_t dltotal, std::size_t dlnow, std::size_t ultotal, std::size_t ulnow) noexcept
+{
+    std::size_t transfered = dlnow + ulnow;
+
+    // The counters go backwards if the transfer is restarted, e.g. on redirect,
+    // so start measuring again from here instead of letting them wrap around.
+    if (dlnow < sample.dl_now || ulnow < sample.ul_now || transfered < last_transfered) {
+        sample.dl_now = dlnow;
+        sample.ul_now = ulnow;
+        last_transfered = transfered;
+        last_time = clock::now();
+        return false;
+    }
+
+    // Check the cheaper condition first to avoid reading the clock
+    if (transfered - last_transfered < min_bytes)
+        return false;
+
+    auto now = clock::now();
+    if (now - last_time < interval)
+        return false;
+
+    double elapsed = std::chrono::duration<double>(now - last_time).count();
+    if (!(elapsed > 0))
+        return false;
+
+    double dl_rate = (dlnow - sample.dl_now) / elapsed;
+    double ul_rate = (ulnow - sample.ul_now) / elapsed;
+
+    if (has_rate) {
+        sample.dl_rate += smoothing * (dl_rate - sample.dl_rate);
+        sample.ul_rate += smoothing * (ul_rate - sample.ul_rate);
+    } else {
+        sample.dl_rate = dl_rate;
+        sample.ul_rate = ul_rate;
+        has_rate = true;
+    }
+
+    sample.dl_total = dltotal;
+    sample.dl_now = dlnow;
+    sample.ul_total = ultotal;
+    sample.ul_now = ulnow;
+    sample.elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - start_time);
+
+    last_time = now;
+    last_transfered = transfered;
+
+    return callback != nullptr;
+}
+
+int Progress_sampler::xferinfo(void *userp, curl_off_t dltotal, curl_off_t dlnow,
+                                            curl_off_t ultotal, curl_off_t ulnow) noexcept
+{
+    auto &sampler = *static_cast<Progress_sampler*>(userp);
+
+    if (!sampler.update(dltotal, dlnow, ultotal, ulnow))
+        return 0;
+
+    switch (sampler.callback(sampler.sample, sampler.userp)) {
+        case action::cont:
+            return 0;
+
+        case action::pause:
+            curl_easy_pause(sampler.curl_easy, CURLPAUSE_ALL);
+            return 0;
+
+        case action::abort:
+        default:
+            return 1;
+    }
+}
+} /* namespace curl */
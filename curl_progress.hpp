@@ -0,0 +1,157 @@
+#ifndef  __curl_cpp_curl_progress_HPP__
+# define __curl_cpp_curl_progress_HPP__
+
+# include "curl_easy.hpp"
+
+# include <cstddef>
+# include <chrono>
+
+namespace curl {
+/**
+ * @example curl_progress.cc
+ *
+ * Progress_sampler throttles the progress meter of libcurl, which is called
+ * whenever data is transfered and can easily be called thousands of times per second.
+ *
+ * The user callback is only called once at least interval has elapsed
+ * and at least min_bytes is transfered since the last sample.
+ *
+ * It also keeps an exponential moving average of the download and upload rate,
+ * so it can be used without any user callback to monitor throughput of a transfer.
+ *
+ * @pre curl_t::has_xferinfo_support()
+ *
+ * Progress_sampler must outlive the transfer it is attached to.
+ * <br>It cannot be attached to multiple Easy_ref_t simultaneously.
+ */
+class Progress_sampler {
+public:
+    using clock = std::chrono::steady_clock;
+
+    struct Sample {
+        /**
+         * 0 if unknown.
+         */
+        std::size_t dl_total = 0;
+        std::size_t dl_now = 0;
+        /**
+         * 0 if unknown.
+         */
+        std::size_t ul_total = 0;
+        std::size_t ul_now = 0;
+
+        /**
+         * Time elapsed since Progress_sampler is attached.
+         */
+        std::chrono::milliseconds elapsed{0};
+
+        /**
+         * Moving average of download/upload rate in bytes per second.
+         */
+        double dl_rate = 0;
+        double ul_rate = 0;
+    };
+
+    enum class action {
+        /**
+         * Continue the transfer.
+         */
+        cont,
+        /**
+         * Pause both directions of the transfer.
+         * <br>Same as Easy_ref_t::set_pause(Easy_ref_t::PauseOptions::all), and
+         * the transfer can be resumed by Easy_ref_t::set_pause(Easy_ref_t::PauseOptions::cont).
+         *
+         * @pre curl_t::has_pause_support()
+         */
+        pause,
+        /**
+         * Abort the transfer, result in Easy_ref_t::code::aborted_by_callback.
+         */
+        abort,
+    };
+
+    /**
+     * @param sample is only valid during the call.
+     *
+     * Must not call any member function of Easy_ref_t or Progress_sampler.
+     */
+    using callback_t = action (*)(const Sample &sample, void *userp);
+
+protected:
+    const clock::duration interval;
+    const std::size_t min_bytes;
+    const double smoothing;
+
+    callback_t callback = nullptr;
+    void *userp = nullptr;
+
+    char *curl_easy = nullptr;
+
+    clock::time_point start_time;
+    clock::time_point last_time;
+    std::size_t last_transfered = 0;
+
+    Sample sample;
+    bool has_rate = false;
+
+    static int xferinfo(void *userp, curl_off_t dltotal, curl_off_t dlnow,
+                                     curl_off_t ultotal, curl_off_t ulnow) noexcept;
+
+    /**
+     * @return true if the user callback should be called.
+     */
+    bool update(std::size_t dltotal, std::size_t dlnow, std::size_t ultotal, std::size_t ulnow) noexcept;
+
+public:
+    /**
+     * @param interval minimal time between two samples.
+     * @param min_bytes minimal number of bytes (download and upload combined) transfered
+     *                  between two samples.
+     *                  <br>If it is not 0, then nothing is sampled while the transfer stalls.
+     * @param smoothing weight of the newest sample in the moving average, in (0, 1].
+     */
+    Progress_sampler(std::chrono::milliseconds interval = std::chrono::milliseconds{1000},
+                     std::size_t min_bytes = 0, double smoothing = 0.3) noexcept;
+
+    Progress_sampler(const Progress_sampler&) = delete;
+    Progress_sampler(Progress_sampler&&) = delete;
+
+    Progress_sampler& operator = (const Progress_sampler&) = delete;
+    Progress_sampler& operator = (Progress_sampler&&) = delete;
+
+    /**
+     * @param callback pass nullptr to only keep track of transfer rate (default).
+     */
+    void set_callback(callback_t callback, void *userp) noexcept;
+
+    /**
+     * @param f must be callable as action (const Sample&) and it must outlive this object.
+     */
+    template <class F>
+    void set_callback(F &f) noexcept
+    {
+        set_callback([](const Sample &sample, void *ptr) {
+            return (*static_cast<F*>(ptr))(sample);
+        }, &f);
+    }
+
+    /**
+     * Reset all statistics and install the progress meter to easy.
+     *
+     * Call it before every transfer.
+     */
+    void attach(Easy_ref_t &easy) noexcept;
+    /**
+     * Uninstall the progress meter from easy.
+     */
+    void detach(Easy_ref_t &easy) noexcept;
+
+    /**
+     * @return the latest sample, which is updated even if there's no user callback.
+     */
+    auto get_sample() const noexcept -> const Sample&;
+};
+} /* namespace curl */
+
+#endif
@@ -0,0 +1,335 @@
+#include "curl_ranged_download.hpp"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace curl {
+/**
+ * Layout of the state file: State_header followed by the bitmap.
+ */
+struct State_header {
+    std::uint64_t magic;
+    std::uint64_t file_size;
+    std::uint64_t block_size;
+};
+static constexpr const std::uint64_t state_magic = 0x6375726c72616e67; // "curlrang"
+
+Ranged_download::Ranged_download(curl_t &curl_arg, Multi_t &multi_arg, const char *url_arg,
+                                 std::size_t file_size_arg, std::size_t block_size_arg) noexcept:
+    curl{curl_arg},
+    multi{multi_arg},
+    url{url_arg},
+    file_size{file_size_arg},
+    block_size{block_size_arg},
+    block_cnt{(file_size_arg + block_size_arg - 1) / block_size_arg}
+{}
+
+void Ranged_download::set_max_retries(unsigned max_retries_arg) noexcept
+{
+    max_retries = max_retries_arg;
+}
+
+static auto make_errno_error(const char *what) noexcept -> Ret_except<void, std::bad_alloc, std::system_error>
+{
+    if (errno == ENOMEM)
+        return {std::bad_alloc{}};
+    return {std::system_error{errno, std::generic_category(), what}};
+}
+auto Ranged_download::open(int out_fd, int state_fd) noexcept ->
+    Ret_except<void, std::bad_alloc, std::system_error>
+{
+    // Allocate disk space in advance, falling back to sparse file
+    if (fallocate(out_fd, 0, 0, file_size) == -1 && ftruncate(out_fd, file_size) == -1)
+        return make_errno_error("In curl::Ranged_download::open: ftruncate failed");
+
+    if (file_size != 0) {
+        void *addr = mmap(nullptr, file_size, PROT_READ | PROT_WRITE, MAP_SHARED, out_fd, 0);
+        if (addr == MAP_FAILED)
+            return make_errno_error("In curl::Ranged_download::open: mmap failed");
+        map = static_cast<char*>(addr);
+    }
+
+    const std::size_t bitmap_len = (block_cnt + 7) / 8;
+
+    if (state_fd == -1) {
+        bitmap_storage.reset(new (std::nothrow) unsigned char[bitmap_len]());
+        if (!bitmap_storage)
+            return {std::bad_alloc{}};
+        bitmap = bitmap_storage.get();
+    } else {
+        struct stat st;
+        if (fstat(state_fd, &st) == -1)
+            return make_errno_error("In curl::Ranged_download::open: fstat failed");
+
+        const std::size_t len = sizeof(State_header) + bitmap_len;
+        if (static_cast<std::size_t>(st.st_size) < len && ftruncate(state_fd, len) == -1)
+            return make_errno_error("In curl::Ranged_download::open: ftruncate failed");
+
+        void *addr = mmap(nullptr, len, PROT_READ | PROT_WRITE, MAP_SHARED, state_fd, 0);
+        if (addr == MAP_FAILED)
+            return make_errno_error("In curl::Ranged_download::open: mmap failed");
+
+        state_map = addr;
+        state_map_len = len;
+
+        auto *header = static_cast<State_header*>(addr);
+        bitmap = reinterpret_cast<unsigned char*>(header + 1);
+
+        if (header->magic != state_magic || header->file_size != file_size ||
+            header->block_size != block_size) {
+            std::memset(bitmap, 0, bitmap_len);
+            *header = State_header{state_magic, file_size, block_size};
+        }
+    }
+
+    completed_cnt = 0;
+    for (std::size_t block = 0; block != block_cnt; ++block)
+        completed_cnt += is_block_completed(block);
+
+    return {};
+}
+
+auto Ranged_download::get_block_end(std::size_t block) const noexcept -> std::size_t
+{
+    return std::min((block + 1) * block_size, file_size);
+}
+bool Ranged_download::is_block_completed(std::size_t block) const noexcept
+{
+    return bitmap[block / 8] & (1U << (block % 8));
+}
+void Ranged_download::mark_completed(Range &range) noexcept
+{
+    for (; range.block != block_cnt && get_block_end(range.block) <= range.pos; ++range.block) {
+        if (!is_block_completed(range.block)) {
+            bitmap[range.block / 8] |= 1U << (range.block % 8);
+            ++completed_cnt;
+        }
+    }
+}
+
+auto Ranged_download::write(Range &range, const char *buffer, std::size_t size) noexcept -> std::size_t
+{
+    if (!range.checked) {
+        long response_code = 0;
+        curl_easy_getinfo(range.easy.get(), CURLINFO_RESPONSE_CODE, &response_code);
+        if (response_code != 206) {
+            // The server ignores "Range" or there's other error.
+            range.unsupported = response_code == 200;
+            return 0;
+        }
+        range.checked = true;
+    }
+
+    std::size_t cnt = std::min(size, range.end - range.pos);
+    std::memcpy(map + range.pos, buffer, cnt);
+    range.pos += cnt;
+
+    mark_completed(range);
+
+    // If the range has been split, stop the transfer once it reaches the new end.
+    return cnt == size ? size : 0;
+}
+
+bool Ranged_download::assign(Range &range) noexcept
+{
+    while (cursor != block_cnt && is_block_completed(cursor))
+        ++cursor;
+
+    std::size_t begin;
+    std::size_t end;
+
+    if (cursor != block_cnt) {
+        std::size_t last = cursor;
+        while (last != block_cnt && last - cursor < blocks_per_range && !is_block_completed(last))
+            ++last;
+
+        begin = cursor * block_size;
+        end = get_block_end(last - 1);
+        cursor = last;
+    } else {
+        // Split the range with most remaining bytes
+        Range *slowest = nullptr;
+        for (std::size_t i = 0; i != range_cnt; ++i) {
+            auto &other = ranges[i];
+            if (other.active && (!slowest || other.end - other.pos > slowest->end - slowest->pos))
+                slowest = &other;
+        }
+        if (!slowest)
+            return false;
+
+        const std::size_t middle = (slowest->pos + slowest->end) / 2;
+        begin = (middle + block_size - 1) / block_size * block_size;
+        if (begin >= slowest->end)
+            return false;
+
+        end = slowest->end;
+        slowest->end = begin;
+    }
+
+    range.pos = begin;
+    range.end = end;
+    range.block = begin / block_size;
+    range.failures = 0;
+
+    start_range(range);
+    return true;
+}
+void Ranged_download::start_range(Range &range) noexcept
+{
+    char range_str[2 * sizeof("18446744073709551615")];
+    std::snprintf(range_str, sizeof(range_str), "%zu-%zu", range.pos, range.end - 1);
+    curl_easy_setopt(range.easy.get(), CURLOPT_RANGE, range_str);
+
+    range.checked = false;
+    range.active = true;
+
+    Easy_ref_t easy_ref{range.easy.get()};
+    multi.add_easy(easy_ref);
+}
+
+auto Ranged_download::start(std::size_t connections) noexcept -> Ret_except<void, std::bad_alloc>
+{
+    const std::size_t remaining = block_cnt - completed_cnt;
+
+    connections = std::max<std::size_t>(std::min(connections, remaining), 1);
+    blocks_per_range = std::max<std::size_t>((remaining + connections - 1) / connections, 1);
+
+    ranges.reset(new (std::nothrow) Range[connections]);
+    if (!ranges)
+        return {std::bad_alloc{}};
+    range_cnt = connections;
+
+    for (std::size_t i = 0; i != range_cnt; ++i) {
+        auto &range = ranges[i];
+
+        range.download = this;
+        range.easy = curl.create_easy();
+        if (!range.easy)
+            return {std::bad_alloc{}};
+
+        Easy_ref_t easy_ref{range.easy.get()};
+
+        easy_ref.request_get();
+
+        bool oom = false;
+        easy_ref.set_url(url).Catch([&](std::bad_alloc) noexcept { oom = true; });
+        if (oom)
+            return {std::bad_alloc{}};
+
+        easy_ref.set_writeback([](char *buffer, std::size_t _, std::size_t size, void *ptr) {
+            auto &range = *static_cast<Range*>(ptr);
+            return range.download->write(range, buffer, size);
+        }, &range);
+        easy_ref.set_private(&range);
+    }
+
+    for (std::size_t i = 0; i != range_cnt; ++i)
+        if (!assign(ranges[i]))
+            break;
+
+    return {};
+}
+
+static bool is_transient(Easy_ref_t::code code) noexcept
+{
+    using code_t = Easy_ref_t::code;
+
+    switch (code) {
+        case code_t::ok:
+        case code_t::cannot_resolve_host:
+        case code_t::cannot_connect:
+        // Also returned if the response isn't 206 or the range is split.
+        case code_t::writeback_error:
+        case code_t::timedout:
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+void Ranged_download::on_finished(Easy_ref_t &easy_ref, Easy_ref_t::perform_ret_t &ret) noexcept
+{
+    // Errors of the transfer itself, e.g. connection dropped, are worth retrying,
+    // while the others would just fail again.
+    bool transient = true;
+    ret.Catch([](std::bad_alloc) noexcept {})
+       .Catch([](Easy_ref_t::Exception) noexcept {})
+       .Catch([](Easy_ref_t::ProtocolInternal_error) noexcept {})
+       .Catch([&](std::invalid_argument) noexcept { transient = false; })
+       .Catch([&](std::length_error) noexcept { transient = false; })
+       .Catch([&](Recursive_api_call_Exception) noexcept { transient = false; })
+       .Catch([&](Easy_ref_t::NotBuiltIn_error) noexcept { transient = false; });
+    if (!ret.has_exception_set())
+        transient = is_transient(ret.get_return_value());
+
+    multi.remove_easy(easy_ref);
+
+    auto &range = *static_cast<Range*>(easy_ref.get_private());
+    range.active = false;
+
+    if (failed)
+        return;
+
+    if (range.pos < range.end) {
+        if (range.unsupported || !transient || ++range.failures > max_retries) {
+            failed = true;
+            return;
+        }
+        // Retry from where it stopped
+        start_range(range);
+    } else
+        assign(range);
+}
+
+auto Ranged_download::perform() noexcept -> Multi_t::perform_ret_t
+{
+    return multi.perform([](Easy_ref_t &easy_ref, Easy_ref_t::perform_ret_t ret, Multi_t&,
+                            Ranged_download *download) noexcept
+    {
+        // Whether the range is completed is determined by bytes received instead of ret,
+        // since a range that is split is stopped by the writeback.
+        download->on_finished(easy_ref, ret);
+    }, this);
+}
+
+bool Ranged_download::is_finished() const noexcept
+{
+    return completed_cnt == block_cnt;
+}
+bool Ranged_download::has_failed() const noexcept
+{
+    return failed;
+}
+
+auto Ranged_download::get_number_of_blocks() const noexcept -> std::size_t
+{
+    return block_cnt;
+}
+auto Ranged_download::get_number_of_completed_blocks() const noexcept -> std::size_t
+{
+    return completed_cnt;
+}
+
+Ranged_download::~Ranged_download()
+{
+    for (std::size_t i = 0; i != range_cnt; ++i) {
+        if (ranges[i].active) {
+            Easy_ref_t easy_ref{ranges[i].easy.get()};
+            multi.remove_easy(easy_ref);
+        }
+    }
+
+    if (map)
+        munmap(map, file_size);
+    if (state_map)
+        munmap(state_map, state_map_len);
+}
+} /* namespace curl */
@@ -0,0 +1,176 @@
+#ifndef  __curl_cpp_curl_ranged_download_HPP__
+# define __curl_cpp_curl_ranged_download_HPP__
+
+# include "curl.hpp"
+# include "curl_easy.hpp"
+# include "curl_multi.hpp"
+
+# include <cstddef>
+# include <cstdint>
+# include <memory>
+# include <new>
+# include <system_error>
+
+namespace curl {
+/**
+ * @example curl_ranged_download.cc
+ *
+ * Ranged_download downloads a file using multiple "Range" requests in parallel
+ * on a Multi_t, which can be either HTTP/2 streams or separate connections
+ * depending on Multi_t::set_multiplexing.
+ *
+ * The output file is preallocated and mmap-ed, and each range is written straight
+ * into its offset of the mapping.
+ *
+ * The file is divided into blocks of block_size:
+ *  - ranges always start at block boundaries;
+ *  - when a connection becomes idle and there's no block left to assign, the
+ *    range with most remaining bytes is split in half, so that a slow connection
+ *    doesn't hold up the whole download;
+ *  - a range that fails with a transient error (e.g. connection dropped or timed out)
+ *    is retried from where it stopped, up to max_retries times, while other errors
+ *    (e.g. malformed url) fail the download immediately;
+ *  - a bitmap records which blocks are complete. If a state file is given,
+ *    the bitmap is mmap-ed from it, so an interrupted download can resume.
+ *
+ * @pre curl_t::has_private_ptr_support() && curl_t::has_multi_poll_support()
+ *      && the server supports range request.
+ *
+ * Ranged_download must not be moved once start() is called.
+ * <br>Multi_t passed to it must not be used for any other transfer while
+ * the download is in progress.
+ */
+class Ranged_download {
+public:
+    static constexpr const std::size_t default_block_size = 1024 * 1024;
+
+protected:
+    struct Range {
+        Ranged_download *download = nullptr;
+        Easy_t easy;
+
+        /**
+         * Next byte to be written.
+         */
+        std::size_t pos = 0;
+        /**
+         * Exclusive, can be shrinked when the range is split.
+         */
+        std::size_t end = 0;
+        /**
+         * Next block to be marked as completed.
+         */
+        std::size_t block = 0;
+
+        unsigned failures = 0;
+        bool active = false;
+        bool checked = false;
+        bool unsupported = false;
+    };
+
+    curl_t &curl;
+    Multi_t &multi;
+    const char *url;
+
+    const std::size_t file_size;
+    const std::size_t block_size;
+    const std::size_t block_cnt;
+
+    char *map = nullptr;
+
+    /**
+     * Points into state_map if state file is used.
+     */
+    unsigned char *bitmap = nullptr;
+    void *state_map = nullptr;
+    std::size_t state_map_len = 0;
+    std::unique_ptr<unsigned char[]> bitmap_storage;
+
+    std::size_t completed_cnt = 0;
+    /**
+     * Blocks before cursor are either completed or assigned to a range.
+     */
+    std::size_t cursor = 0;
+    std::size_t blocks_per_range = 1;
+
+    std::unique_ptr<Range[]> ranges;
+    std::size_t range_cnt = 0;
+
+    unsigned max_retries = 3;
+    bool failed = false;
+
+    auto get_block_end(std::size_t block) const noexcept -> std::size_t;
+    bool is_block_completed(std::size_t block) const noexcept;
+    void mark_completed(Range &range) noexcept;
+
+    auto write(Range &range, const char *buffer, std::size_t size) noexcept -> std::size_t;
+
+    /**
+     * @return false if there's nothing left to assign.
+     */
+    bool assign(Range &range) noexcept;
+    void start_range(Range &range) noexcept;
+    /**
+     * @param ret result of the transfer, all exceptions in it are caught.
+     */
+    void on_finished(Easy_ref_t &easy_ref, Easy_ref_t::perform_ret_t &ret) noexcept;
+
+public:
+    /**
+     * @param url must be kept around until the download is done.
+     * @param file_size size of the file to be downloaded, e.g. from a HEAD request.
+     * @param block_size granularity of ranges and of the completion bitmap.
+     */
+    Ranged_download(curl_t &curl, Multi_t &multi, const char *url, std::size_t file_size,
+                    std::size_t block_size = default_block_size) noexcept;
+
+    Ranged_download(const Ranged_download&) = delete;
+    Ranged_download& operator = (const Ranged_download&) = delete;
+
+    void set_max_retries(unsigned max_retries) noexcept;
+
+    /**
+     * @param out_fd must be opened for reading and writing, and would be resized to file_size.
+     *               <br>It can be closed after this call.
+     * @param state_fd optional, must be opened for reading and writing.
+     *                 <br>If it contains the state of an interrupted download of the
+     *                 same file_size and block_size, completed blocks are not downloaded again;
+     *                 otherwise it is initialized.
+     *                 <br>It can be closed after this call.
+     */
+    auto open(int out_fd, int state_fd = -1) noexcept -> Ret_except<void, std::bad_alloc, std::system_error>;
+
+    /**
+     * @pre open() is called.
+     * @param connections number of ranges to download in parallel.
+     *
+     * Add easy handles to the multi, call perform() to start the transfer.
+     */
+    auto start(std::size_t connections) noexcept -> Ret_except<void, std::bad_alloc>;
+
+    /**
+     * Same as Multi_t::perform, except that finished handles are handled internally.
+     */
+    auto perform() noexcept -> Multi_t::perform_ret_t;
+
+    bool is_finished() const noexcept;
+    /**
+     * @return true if any range failed more than max_retries times, failed with
+     *         an error that is not worth retrying, or the server doesn't support range request.
+     *
+     * In that case, the download should be abandoned and resumed later
+     * with the state file.
+     */
+    bool has_failed() const noexcept;
+
+    auto get_number_of_blocks() const noexcept -> std::size_t;
+    auto get_number_of_completed_blocks() const noexcept -> std::size_t;
+
+    /**
+     * Remove all handles from multi and unmap the output file and the state file.
+     */
+    ~Ranged_download();
+};
+} /* namespace curl */
+
+#endif
@@ -0,0 +1,95 @@
+#include "curl_submission_queue.hpp"
+
+#include <cerrno>
+#include <cstdint>
+
+#include <unistd.h>
+#include <sys/eventfd.h>
+
+namespace curl {
+Submission_queue::Submission_queue(Multi_t &multi_arg) noexcept:
+    multi{multi_arg}
+{}
+
+auto Submission_queue::enable_eventfd() noexcept -> Ret_except<void, std::system_error>
+{
+    eventfd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (eventfd == -1)
+        return {std::system_error{errno, std::generic_category(),
+                                  "In curl::Submission_queue::enable_eventfd: eventfd failed"}};
+    return {};
+}
+int Submission_queue::get_eventfd() const noexcept
+{
+    return eventfd;
+}
+
+void Submission_queue::notify() noexcept
+{
+    if (eventfd != -1) {
+        std::uint64_t value = 1;
+        write(eventfd, &value, sizeof(value));
+    } else
+        multi.wakeup();
+}
+
+auto Submission_queue::push(Easy_t &easy) noexcept -> Ret_except<void, std::bad_alloc>
+{
+    auto *node = new (std::nothrow) Node{easy.get(), nullptr};
+    if (!node)
+        return {std::bad_alloc{}};
+
+    Node *old = head.load(std::memory_order_relaxed);
+    do {
+        node->next = old;
+    } while (!head.compare_exchange_weak(old, node, std::memory_order_release, std::memory_order_relaxed));
+
+    easy.release();
+
+    // Only the first push after drain() needs to wake up the event loop.
+    if (!old)
+        notify();
+
+    return {};
+}
+
+auto Submission_queue::take_all() noexcept -> Node*
+{
+    if (eventfd != -1) {
+        // Clear the eventfd before taking the nodes, so that a push after
+        // that would notify again.
+        std::uint64_t value;
+        read(eventfd, &value, sizeof(value));
+    }
+
+    // The whole stack is taken at once, so there's no ABA problem.
+    Node *node = head.exchange(nullptr, std::memory_order_acquire);
+
+    // Reverse to the order they are pushed.
+    Node *prev = nullptr;
+    while (node) {
+        Node *next = node->next;
+        node->next = prev;
+        prev = node;
+        node = next;
+    }
+    return prev;
+}
+
+auto Submission_queue::drain() noexcept -> std::size_t
+{
+    return drain([this](Easy_ref_t &easy_ref) noexcept {
+        multi.add_easy(easy_ref);
+    });
+}
+
+Submission_queue::~Submission_queue()
+{
+    drain([](Easy_ref_t &easy_ref) noexcept {
+        Easy_t easy{easy_ref.curl_easy};
+    });
+
+    if (eventfd != -1)
+        close(eventfd);
+}
+} /* namespace curl */
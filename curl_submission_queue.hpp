@@ -0,0 +1,121 @@
+#ifndef  __curl_cpp_curl_submission_queue_HPP__
+# define __curl_cpp_curl_submission_queue_HPP__
+
+# include "curl.hpp"
+# include "curl_easy.hpp"
+# include "curl_multi.hpp"
+
+# include <cstddef>
+# include <atomic>
+# include <new>
+# include <system_error>
+
+namespace curl {
+/**
+ * @example curl_submission_queue.cc
+ *
+ * Submission_queue lets other threads submit easy handles to a Multi_t,
+ * which must only be used by the thread running its event loop.
+ *
+ * It is a lock-free multi-producer single-consumer queue:
+ *  - push() links the handle into a lock-free stack, and wakes up
+ *    the event loop only if the queue was empty, so a burst of
+ *    submissions costs one wakeup;
+ *  - drain() takes the whole stack at once and adds handles to Multi_t
+ *    in the order they are pushed.
+ *
+ * The event loop is woken up via either:
+ *  - Multi_t::wakeup(), which breaks Multi_t::poll(), the default;
+ *  - an eventfd, for Multi_epoll_t, Multi_uring_t or any other event loop
+ *    driving Multi_t::multi_socket_action, see enable_eventfd().
+ */
+class Submission_queue {
+protected:
+    struct Node {
+        char *curl_easy;
+        Node *next;
+    };
+
+    Multi_t &multi;
+
+    std::atomic<Node*> head{nullptr};
+    int eventfd = -1;
+
+    void notify() noexcept;
+    /**
+     * @return nodes in the order they are pushed.
+     */
+    auto take_all() noexcept -> Node*;
+
+public:
+    /**
+     * @pre curl_t::has_multi_wakeup_support() unless enable_eventfd() is called.
+     */
+    Submission_queue(Multi_t &multi) noexcept;
+
+    Submission_queue(const Submission_queue&) = delete;
+    Submission_queue(Submission_queue&&) = delete;
+
+    Submission_queue& operator = (const Submission_queue&) = delete;
+    Submission_queue& operator = (Submission_queue&&) = delete;
+
+    /**
+     * Use an eventfd instead of Multi_t::wakeup() to wake up the event loop.
+     *
+     * Must be called before any push().
+     */
+    auto enable_eventfd() noexcept -> Ret_except<void, std::system_error>;
+    /**
+     * @return the eventfd, which becomes readable when handles are pushed,
+     *         -1 if enable_eventfd() is not called.
+     *         <br>It should be polled for POLLIN/EPOLLIN level-triggered and
+     *         is cleared by drain().
+     */
+    int get_eventfd() const noexcept;
+
+    /**
+     * Thread-safe.
+     *
+     * @param easy must be fully configured. It is released on success.
+     */
+    auto push(Easy_t &easy) noexcept -> Ret_except<void, std::bad_alloc>;
+
+    /**
+     * Can only be called by the thread running the event loop of multi.
+     *
+     * Add all handles pushed to multi.
+     *
+     * @return number of handles added.
+     */
+    auto drain() noexcept -> std::size_t;
+    /**
+     * Can only be called by the thread running the event loop of multi.
+     *
+     * @param f called with (Easy_ref_t&) for each handle pushed, in the order
+     *          they are pushed. It takes over the ownership of the handle.
+     * @return number of handles drained.
+     */
+    template <class F>
+    auto drain(F &&f) noexcept -> std::size_t
+    {
+        std::size_t cnt = 0;
+        for (Node *node = take_all(); node; ++cnt) {
+            Easy_ref_t easy_ref{node->curl_easy};
+
+            Node *next = node->next;
+            delete node;
+            node = next;
+
+            f(easy_ref);
+        }
+        return cnt;
+    }
+
+    /**
+     * Free handles left in the queue and close the eventfd.
+     */
+    ~Submission_queue();
+};
+} /* namespace curl */
+
+#endif
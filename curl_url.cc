@@ -109,6 +109,14 @@ auto Url_ref_t::get_scheme() const noexcept -> Ret_except<string, get_code, std:
 {
     return curl_urlget_wrapper(url, CURLUPART_SCHEME);
 }
+auto Url_ref_t::get_host() const noexcept -> Ret_except<string, get_code, std::bad_alloc>
+{
+    return curl_urlget_wrapper(url, CURLUPART_HOST);
+}
+auto Url_ref_t::get_port() const noexcept -> Ret_except<string, get_code, std::bad_alloc>
+{
+    return curl_urlget_wrapper(url, CURLUPART_PORT);
+}
 auto Url_ref_t::get_options() const noexcept -> Ret_except<string, get_code, std::bad_alloc>
 {
     return curl_urlget_wrapper(url, CURLUPART_OPTIONS);
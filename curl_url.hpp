@@ -97,6 +97,11 @@ public:
     auto get_url() const noexcept -> Ret_except<string, get_code, std::bad_alloc>;
 
     auto get_scheme() const noexcept -> Ret_except<string, get_code, std::bad_alloc>;
+    auto get_host() const noexcept -> Ret_except<string, get_code, std::bad_alloc>;
+    /**
+     * @return no_port if port is not specified in the url.
+     */
+    auto get_port() const noexcept -> Ret_except<string, get_code, std::bad_alloc>;
     auto get_options() const noexcept -> Ret_except<string, get_code, std::bad_alloc>;
     auto get_query() const noexcept -> Ret_except<string, get_code, std::bad_alloc>;
 };
@@ -0,0 +1 @@
+../test/test_curl_blocking_client.cc
\ No newline at end of file
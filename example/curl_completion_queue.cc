@@ -0,0 +1 @@
+../test/test_curl_completion_queue.cc
\ No newline at end of file
@@ -0,0 +1 @@
+../test/test_curl_coroutine.cc
\ No newline at end of file
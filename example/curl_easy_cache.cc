@@ -0,0 +1 @@
+../test/test_curl_easy_cache.cc
\ No newline at end of file
@@ -0,0 +1 @@
+../test/test_curl_easy_pool.cc
\ No newline at end of file
@@ -0,0 +1 @@
+../test/test_curl_header.cc
\ No newline at end of file
@@ -0,0 +1 @@
+../test/test_curl_host_router.cc
\ No newline at end of file
@@ -0,0 +1 @@
+../test/test_curl_multi_epoll.cc
\ No newline at end of file
@@ -0,0 +1 @@
+../test/test_curl_multi_finished_batch.cc
\ No newline at end of file
@@ -0,0 +1 @@
+../test/test_curl_multi_runtime.cc
\ No newline at end of file
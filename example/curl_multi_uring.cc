@@ -0,0 +1 @@
+../test/test_curl_multi_uring.cc
\ No newline at end of file
@@ -0,0 +1 @@
+../test/test_curl_options.cc
\ No newline at end of file
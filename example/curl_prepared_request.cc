@@ -0,0 +1 @@
+../test/test_curl_prepared_request.cc
\ No newline at end of file
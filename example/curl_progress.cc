@@ -0,0 +1 @@
+../test/test_curl_progress.cc
\ No newline at end of file
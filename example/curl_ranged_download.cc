@@ -0,0 +1 @@
+../test/test_curl_ranged_download.cc
\ No newline at end of file
@@ -0,0 +1 @@
+../test/test_curl_submission_queue.cc
\ No newline at end of file
@@ -0,0 +1 @@
+../test/test_curl_transfer_report.cc
\ No newline at end of file
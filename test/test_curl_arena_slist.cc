@@ -0,0 +1,96 @@
+#include "../curl_easy.hpp"
+#include "../utils/arena_slist.hpp"
+#include "../utils/header_set.hpp"
+
+#include <cassert>
+#include <string>
+#include "utility.hpp"
+
+using curl::Easy_ref_t;
+
+static constexpr const auto header_cnt = 100UL;
+
+void test_header_overlay()
+{
+    curl::utils::arena_slist common;
+    common.push_back("User-Agent: curl-cpp");
+    common.push_back("Accept: */*");
+
+    auto base = curl::utils::header_set::create(std::move(common)).get_return_value();
+
+    curl::utils::header_overlay overlay1{base};
+    curl::utils::header_overlay overlay2{base};
+
+    // Overlay with no header of its own is the same as base
+    assert_same(*overlay1.begin(), std::string_view{"User-Agent: curl-cpp"});
+
+    overlay1.push_back("X-Request-Id: 1");
+    for (auto i = 0; i != 20; ++i)
+        overlay2.push_back("X-Padding: 0123456789abcdef0123456789abcdef");
+    overlay2.push_back("X-Request-Id: 2");
+
+    const char *expected1[] = {"X-Request-Id: 1", "User-Agent: curl-cpp", "Accept: */*"};
+    auto i = 0UL;
+    for (std::string_view header: overlay1)
+        assert_same(header, std::string_view{expected1[i++]});
+    assert_same(i, 3UL);
+
+    i = 0UL;
+    for (std::string_view header: overlay2) {
+        if (i == 20)
+            assert_same(header, std::string_view{"X-Request-Id: 2"});
+        ++i;
+    }
+    assert_same(i, 23UL);
+
+    overlay1.clear();
+    assert_same(*overlay1.begin(), std::string_view{"User-Agent: curl-cpp"});
+}
+
+int main(int argc, char* argv[])
+{
+    test_header_overlay();
+
+    curl::utils::arena_slist l;
+    assert(l.is_empty());
+
+    // Force the memory block to grow and being moved several times
+    for (auto i = 0UL; i != header_cnt; ++i)
+        l.push_back(("X-Header-" + std::to_string(i) + ": " + std::string(i, 'v')).c_str());
+
+    assert_same(l.size(), header_cnt);
+
+    auto i = 0UL;
+    for (std::string_view header: l) {
+        assert_same(header, "X-Header-" + std::to_string(i) + ": " + std::string(i, 'v'));
+        ++i;
+    }
+    assert_same(i, header_cnt);
+
+    l.clear();
+    assert(l.is_empty());
+
+    l.push_back("Accept: text/html");
+    l.push_back("X-Trace-Id: 12345", 10);
+    assert_same(*l.begin(), std::string_view{"Accept: text/html"});
+    assert_same(*++l.begin(), std::string_view{"X-Trace-Id"});
+
+    curl::curl_t curl{nullptr};
+
+    auto easy = curl.create_easy();
+    assert(easy);
+
+    auto easy_ref = Easy_ref_t{easy.get()};
+
+    easy_ref.request_get();
+    easy_ref.set_url("http://localhost:8787/");
+    easy_ref.set_http_header(l);
+
+    std::string response;
+    easy_ref.set_readall_writeback(response);
+
+    assert_same(easy_ref.perform().get_return_value(), Easy_ref_t::code::ok);
+    assert_same(easy_ref.get_response_code(), 200L);
+
+    return 0;
+}
@@ -0,0 +1,82 @@
+/**
+ * Example/test for using Blocking_client.
+ */
+
+#include "../curl_easy.hpp"
+#include "../curl_blocking_client.hpp"
+
+#include <cassert>
+#include <atomic>
+#include <string>
+#include <pthread.h>
+#include "utility.hpp"
+
+using curl::Easy_ref_t;
+
+static constexpr const auto thread_cnt = 16UL;
+static constexpr const auto requests_per_thread = 5UL;
+static constexpr const auto expected_response = "<p>Hello, world!\\n</p>\n";
+
+struct Caller {
+    curl::curl_t *curl;
+    curl::Blocking_client *client;
+    std::atomic<std::size_t> *completed;
+    pthread_t thread;
+};
+
+void* call(void *arg) noexcept
+{
+    auto &caller = *static_cast<Caller*>(arg);
+
+    auto easy = caller.curl->create_easy();
+    assert(easy);
+
+    auto easy_ref = Easy_ref_t{easy.get()};
+    easy_ref.request_get();
+    easy_ref.set_url("http://localhost:8787/");
+
+    std::string response;
+    easy_ref.set_readall_writeback(response);
+    easy_ref.set_private(&caller);
+
+    for (auto i = 0UL; i != requests_per_thread; ++i) {
+        assert_same(caller.client->perform(easy_ref).get_return_value(), Easy_ref_t::code::ok);
+        assert_same(easy_ref.get_response_code(), 200L);
+        assert_same(easy_ref.get_private(), arg);
+
+        assert_same(response, expected_response);
+        response.clear();
+
+        ++*caller.completed;
+    }
+
+    return nullptr;
+}
+
+int main(int argc, char* argv[])
+{
+    curl::curl_t curl{nullptr};
+    assert(curl.has_private_ptr_support());
+    assert(curl.has_multi_poll_support());
+    assert(curl.has_multi_wakeup_support());
+
+    curl::Blocking_client client{curl};
+    client.set_multiplexing(30);
+    client.start().get_return_value();
+
+    std::atomic<std::size_t> completed{0};
+
+    Caller callers[thread_cnt];
+    for (auto &caller: callers) {
+        caller = Caller{&curl, &client, &completed, {}};
+        assert_same(pthread_create(&caller.thread, nullptr, call, &caller), 0);
+    }
+    for (auto &caller: callers)
+        assert_same(pthread_join(caller.thread, nullptr), 0);
+
+    client.stop();
+
+    assert_same(completed.load(), thread_cnt * requests_per_thread);
+
+    return 0;
+}
@@ -0,0 +1,110 @@
+/**
+ * Example/test for using Completion_queue.
+ *
+ * Each handle is used for two transfers: the consumer processes the result
+ * and gives back the handle, then the network thread reuses it.
+ */
+
+#include "../curl_easy.hpp"
+#include "../curl_multi.hpp"
+#include "../curl_completion_queue.hpp"
+
+#include <cassert>
+#include <string>
+#include <pthread.h>
+#include "utility.hpp"
+
+using curl::Easy_ref_t;
+
+static constexpr const auto connection_cnt = 20UL;
+static constexpr const auto rounds = 2;
+static constexpr const auto expected_response = "<p>Hello, world!\\n</p>\n";
+
+struct Request {
+    std::string response;
+    int round = 0;
+};
+
+void* consume(void *arg) noexcept
+{
+    auto &queue = *static_cast<curl::Completion_queue*>(arg);
+
+    curl::Completion_queue::Finished_easy finished[8];
+    for (auto completed = 0UL; completed != connection_cnt * rounds; ) {
+        queue.wait(-1).get_return_value();
+
+        for (std::size_t cnt; (cnt = queue.pop(finished, 8)); completed += cnt)
+            for (auto i = 0UL; i != cnt; ++i) {
+                auto &easy_ref = finished[i].easy_ref;
+
+                assert_same(finished[i].get_result().get_return_value(), Easy_ref_t::code::ok);
+                assert_same(easy_ref.get_response_code(), 200L);
+
+                auto &request = *static_cast<Request*>(easy_ref.get_private());
+                assert_same(request.response, expected_response);
+                request.response.clear();
+                ++request.round;
+
+                curl::Easy_t easy{easy_ref.curl_easy};
+                while (!queue.give_back(easy));
+            }
+    }
+
+    return nullptr;
+}
+
+int main(int argc, char* argv[])
+{
+    curl::curl_t curl{nullptr};
+    assert(curl.has_private_ptr_support());
+    assert(curl.has_multi_poll_support());
+
+    auto multi = curl.create_multi().get_return_value();
+
+    curl::Completion_queue queue;
+    queue.init(8).get_return_value();
+
+    for (auto i = 0UL; i != connection_cnt; ++i) {
+        auto easy = curl.create_easy();
+        assert(easy);
+
+        auto easy_ref = Easy_ref_t{easy.release()};
+
+        easy_ref.request_get();
+        easy_ref.set_url("http://localhost:8787/");
+
+        auto *request = new Request;
+        easy_ref.set_readall_writeback(request->response);
+        easy_ref.set_private(request);
+
+        multi.add_easy(easy_ref);
+    }
+
+    pthread_t consumer;
+    assert_same(pthread_create(&consumer, nullptr, consume, &queue), 0);
+
+    std::size_t freed = 0;
+    while (freed != connection_cnt) {
+        multi.perform().get_return_value();
+        queue.collect(multi);
+
+        queue.recycle([&](Easy_ref_t &easy_ref) noexcept {
+            auto *request = static_cast<Request*>(easy_ref.get_private());
+            if (request->round != rounds)
+                multi.add_easy(easy_ref);
+            else {
+                curl::Easy_t easy{easy_ref.curl_easy};
+                delete request;
+                ++freed;
+            }
+        });
+
+        // Handles given back don't wake up the network thread.
+        multi.poll(nullptr, 0, 10).get_return_value();
+    }
+
+    assert_same(pthread_join(consumer, nullptr), 0);
+    assert_same(multi.get_number_of_handles(), 0UL);
+
+    return 0;
+}
@@ -0,0 +1,100 @@
+/**
+ * Example/test for awaiting transfers in C++20 coroutines,
+ * driven by Multi_t::poll and Multi_epoll_t.
+ *
+ * Does nothing unless compiled with C++20.
+ */
+
+#include "../curl_easy.hpp"
+#include "../curl_multi.hpp"
+#include "../curl_multi_epoll.hpp"
+#include "../curl_coroutine.hpp"
+
+#include <cassert>
+#include <string>
+#include "utility.hpp"
+
+#ifdef CURL_CPP_HAS_COROUTINE
+using curl::Easy_ref_t;
+
+static constexpr const auto coroutine_cnt = 20UL;
+static constexpr const auto requests_per_coroutine = 3UL;
+static constexpr const auto expected_response = "<p>Hello, world!\\n</p>\n";
+
+curl::Task download(curl::curl_t &curl, curl::Multi_t &multi, std::size_t &completed)
+{
+    auto easy = curl.create_easy();
+    assert(easy);
+
+    auto easy_ref = Easy_ref_t{easy.get()};
+    easy_ref.request_get();
+    easy_ref.set_url("http://localhost:8787/");
+
+    std::string response;
+    easy_ref.set_readall_writeback(response);
+    easy_ref.set_private(&response);
+
+    for (auto i = 0UL; i != requests_per_coroutine; ++i) {
+        auto ret = co_await curl::fetch(multi, easy_ref);
+
+        assert_same(ret.get_return_value(), Easy_ref_t::code::ok);
+        assert_same(easy_ref.get_response_code(), 200L);
+        assert_same(easy_ref.get_private(), static_cast<void*>(&response));
+
+        assert_same(response, expected_response);
+        response.clear();
+
+        ++completed;
+    }
+}
+
+void test_poll(curl::curl_t &curl)
+{
+    auto multi = curl.create_multi().get_return_value();
+
+    std::size_t completed = 0;
+    for (auto i = 0UL; i != coroutine_cnt; ++i)
+        assert(download(curl, multi, completed));
+
+    do {
+        multi.perform(curl::resume_fetch, nullptr).get_return_value();
+    } while (multi.break_or_poll().get_return_value() != -1);
+
+    assert_same(completed, coroutine_cnt * requests_per_coroutine);
+}
+
+void test_epoll(curl::curl_t &curl)
+{
+    auto multi = curl.create_multi().get_return_value();
+
+    curl::Multi_epoll_t epoll{multi, 8};
+    epoll.init().get_return_value();
+
+    std::size_t completed = 0;
+    for (auto i = 0UL; i != coroutine_cnt; ++i)
+        assert(download(curl, multi, completed));
+
+    epoll.start(curl::resume_fetch, nullptr).get_return_value();
+    while (multi.get_number_of_handles()) {
+        epoll.wait(-1).get_return_value();
+        epoll.perform(curl::resume_fetch, nullptr).get_return_value();
+    }
+
+    assert_same(completed, coroutine_cnt * requests_per_coroutine);
+}
+#endif
+
+int main(int argc, char* argv[])
+{
+#ifdef CURL_CPP_HAS_COROUTINE
+    curl::curl_t curl{nullptr};
+    assert(curl.has_private_ptr_support());
+    assert(curl.has_multi_poll_support());
+    assert(curl.has_multi_socket_support());
+
+    test_poll(curl);
+    test_epoll(curl);
+#endif
+
+    return 0;
+}
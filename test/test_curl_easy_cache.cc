@@ -0,0 +1,79 @@
+/**
+ * Example/test for using Easy_cache.
+ */
+
+#include "../curl_easy.hpp"
+#include "../curl_easy_cache.hpp"
+
+#include <cassert>
+#include <string>
+#include <pthread.h>
+#include "utility.hpp"
+
+using curl::Easy_ref_t;
+
+static constexpr const auto thread_cnt = 8UL;
+static constexpr const auto requests_per_thread = 5UL;
+static constexpr const auto expected_response = "<p>Hello, world!\\n</p>\n";
+
+void get(curl::Easy_cache::Local &local, const char *host, const char *url)
+{
+    auto easy_ref = local.get_easy(host).get_return_value();
+
+    easy_ref.request_get();
+    easy_ref.set_url(url);
+
+    std::string response;
+    easy_ref.set_readall_writeback(response);
+
+    assert_same(easy_ref.perform().get_return_value(), Easy_ref_t::code::ok);
+    assert_same(easy_ref.get_response_code(), 200L);
+    assert_same(response, expected_response);
+}
+
+void* run(void *arg) noexcept
+{
+    thread_local curl::Easy_cache::Local local{*static_cast<curl::Easy_cache*>(arg)};
+
+    for (auto i = 0UL; i != requests_per_thread; ++i) {
+        auto easy_ref = local.get_easy("localhost:8787").get_return_value();
+        // The handle is reused for the same host
+        assert_same(local.get_easy("localhost:8787").get_return_value().curl_easy, easy_ref.curl_easy);
+
+        get(local, "localhost:8787", "http://localhost:8787/");
+    }
+    assert_same(local.get_number_of_easy(), 1UL);
+
+    return nullptr;
+}
+
+int main(int argc, char* argv[])
+{
+    curl::curl_t curl{nullptr};
+
+    curl::Easy_cache cache{curl};
+    cache.init().get_return_value();
+
+    pthread_t threads[thread_cnt];
+    for (auto &thread: threads)
+        assert_same(pthread_create(&thread, nullptr, run, &cache), 0);
+    for (auto &thread: threads)
+        assert_same(pthread_join(thread, nullptr), 0);
+
+    {
+        // The least recently used host is evicted
+        curl::Easy_cache::Local local{cache, 2};
+
+        get(local, "localhost:8787", "http://localhost:8787/");
+        get(local, "127.0.0.1:8787", "http://127.0.0.1:8787/");
+        get(local, "localhost:8787", "http://localhost:8787/");
+        assert_same(local.get_number_of_easy(), 2UL);
+
+        auto localhost = local.get_easy("localhost:8787").get_return_value();
+        local.get_easy("example.com").get_return_value();
+        assert_same(local.get_number_of_easy(), 2UL);
+        assert_same(local.get_easy("localhost:8787").get_return_value().curl_easy, localhost.curl_easy);
+    }
+
+    return 0;
+}
@@ -0,0 +1,72 @@
+/**
+ * Example/test for recycling easy handles with Easy_pool and Multi_t::poll interface.
+ */
+
+#include "../curl_easy.hpp"
+#include "../curl_multi.hpp"
+#include "../curl_easy_pool.hpp"
+
+#include <cassert>
+#include <string>
+#include "utility.hpp"
+
+using curl::Easy_ref_t;
+
+static constexpr const auto connection_cnt = 20UL;
+static constexpr const auto round_cnt = 3UL;
+static constexpr const auto expected_response = "<p>Hello, world!\\n</p>\n";
+
+int main(int argc, char* argv[])
+{
+    curl::curl_t curl{nullptr};
+    assert(curl.has_private_ptr_support());
+    assert(curl.has_multi_poll_support());
+
+    curl::Easy_pool pool{curl};
+    assert_same(pool.reserve(connection_cnt), connection_cnt);
+    assert_same(pool.get_number_of_idle_easy(), connection_cnt);
+
+    auto multi = curl.create_multi().get_return_value();
+
+    std::string responses[connection_cnt];
+    {
+        curl::Easy_pool::Cache cache{pool, 4};
+
+        auto perform_callback = cache.recycle_on_finished([](Easy_ref_t &easy_ref, Easy_ref_t::perform_ret_t ret,
+                                                             curl::Multi_t &multi, void*) noexcept
+        {
+            assert_same(ret.get_return_value(), Easy_ref_t::code::ok);
+            assert_same(easy_ref.get_response_code(), 200L);
+        });
+
+        for (auto round = 0UL; round != round_cnt; ++round) {
+            for (auto &response: responses) {
+                response.clear();
+
+                auto easy = cache.get_easy();
+                assert(easy);
+
+                auto easy_ref = Easy_ref_t{easy.release()};
+
+                easy_ref.request_get();
+                easy_ref.set_url("http://localhost:8787/");
+
+                easy_ref.set_readall_writeback(response);
+
+                multi.add_easy(easy_ref);
+            }
+
+            do {
+                multi.perform(perform_callback, nullptr);
+            } while (multi.break_or_poll().get_return_value() != -1);
+
+            for (auto &response: responses)
+                assert_same(response, expected_response);
+        }
+    }
+
+    // No handle is created or destroyed after reserve.
+    assert_same(pool.get_number_of_idle_easy(), connection_cnt);
+
+    return 0;
+}
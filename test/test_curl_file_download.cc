@@ -0,0 +1,171 @@
+#include "../curl_easy.hpp"
+#include "../utils/file_sink.hpp"
+
+#include <cassert>
+#include <cstdio>
+#include <string>
+#include "utility.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+using curl::Easy_ref_t;
+using curl::utils::file_sink;
+
+static constexpr const auto expected_response = "<p>Hello, world!\\n</p>\n";
+
+static auto read_file(const char *path) -> std::string
+{
+    std::string content;
+
+    FILE *file = std::fopen(path, "rb");
+    assert(file);
+
+    char buffer[4096];
+    for (std::size_t cnt; (cnt = std::fread(buffer, 1, sizeof(buffer), file)) != 0; )
+        content.append(buffer, cnt);
+
+    std::fclose(file);
+    return content;
+}
+static void write_file(const char *path, const std::string &content)
+{
+    FILE *file = std::fopen(path, "wb");
+    assert(file);
+    assert_same(std::fwrite(content.data(), 1, content.size(), file), content.size());
+    std::fclose(file);
+}
+
+int main(int argc, char* argv[])
+{
+    curl::curl_t curl{nullptr};
+
+    const char *src_path = "/tmp/curl_cpp_test_download_src";
+    const char *dest_path = "/tmp/curl_cpp_test_download_dest";
+
+    auto easy = curl.create_easy();
+    assert(easy);
+
+    auto easy_ref = Easy_ref_t{easy.get()};
+
+    // Download via http
+    {
+        int fd = open(dest_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        assert(fd != -1);
+
+        auto sink = file_sink::create(fd).get_return_value();
+
+        easy_ref.request_get();
+        easy_ref.set_url("http://localhost:8787/");
+        easy_ref.set_file_writeback(sink);
+
+        assert_same(easy_ref.perform().get_return_value(), Easy_ref_t::code::ok);
+        assert_same(easy_ref.get_response_code(), 200L);
+
+        sink.finish().get_return_value();
+        close(fd);
+
+        assert_same(read_file(dest_path), std::string{expected_response});
+    }
+
+    std::string content;
+    for (int i = 0; i != 100000; ++i)
+        content += std::to_string(i);
+    write_file(src_path, content);
+
+    std::string url = "file://";
+    url += src_path;
+    easy_ref.set_url(url.c_str());
+
+    // Resume a partially downloaded file, with small buffer to test coalescing
+    {
+        write_file(dest_path, content.substr(0, 50000));
+
+        int fd = open(dest_path, O_WRONLY);
+        assert(fd != -1);
+
+        auto sink = file_sink::create(fd, true, false, 4096).get_return_value();
+        assert_same(sink.get_resume_offset(), 50000UL);
+
+        easy_ref.set_file_writeback(sink);
+        assert_same(easy_ref.perform().get_return_value(), Easy_ref_t::code::ok);
+
+        sink.finish().get_return_value();
+        close(fd);
+
+        assert_same(read_file(dest_path), content);
+    }
+
+    // Resume offset is beyond the end of remote file
+    {
+        write_file(dest_path, content + "garbage");
+
+        int fd = open(dest_path, O_WRONLY);
+        assert(fd != -1);
+
+        auto sink = file_sink::create(fd, true).get_return_value();
+
+        easy_ref.set_file_writeback(sink);
+        assert_same(easy_ref.perform().get_return_value(), Easy_ref_t::code::range_error);
+
+        sink.restart();
+        easy_ref.set_file_writeback(sink);
+        assert_same(easy_ref.perform().get_return_value(), Easy_ref_t::code::ok);
+
+        sink.finish().get_return_value();
+        close(fd);
+
+        assert_same(read_file(dest_path), content);
+    }
+
+    // O_DIRECT, which isn't supported by every file system.
+    {
+        write_file(dest_path, content.substr(0, 10000));
+
+        int fd = open(dest_path, O_WRONLY);
+        assert(fd != -1);
+
+        bool unsupported = false;
+        auto result = file_sink::create(fd, true, true);
+        result.Catch([&](std::system_error) noexcept { unsupported = true; });
+        if (!unsupported) {
+            auto sink = std::move(result).get_return_value();
+            assert(sink.is_direct());
+            assert_same(sink.get_resume_offset(), 8192UL);
+
+            easy_ref.set_file_writeback(sink);
+            assert_same(easy_ref.perform().get_return_value(), Easy_ref_t::code::ok);
+
+            sink.finish().get_return_value();
+
+            assert_same(read_file(dest_path), content);
+        }
+
+        close(fd);
+    }
+
+    // Content-Length of a response without body, e.g. a redirect, is not preallocated.
+    {
+        int fd = open(dest_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        assert(fd != -1);
+
+        auto sink = file_sink::create(fd).get_return_value();
+
+        sink.set_expected_size(64 * 1024 * 1024);
+        sink.set_expected_size(0);
+        assert(sink.write(content.data(), 100));
+
+        struct stat st;
+        assert_same(fstat(fd, &st), 0);
+        assert(st.st_blocks * 512 < 1024 * 1024);
+
+        sink.finish().get_return_value();
+        close(fd);
+    }
+
+    unlink(src_path);
+    unlink(dest_path);
+
+    return 0;
+}
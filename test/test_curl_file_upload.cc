@@ -0,0 +1,123 @@
+#include "../curl_easy.hpp"
+#include "../utils/file_source.hpp"
+
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include "utility.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+using curl::Easy_ref_t;
+using curl::utils::file_source;
+
+static auto read_file(const char *path) -> std::string
+{
+    std::string content;
+
+    FILE *file = std::fopen(path, "rb");
+    assert(file);
+
+    char buffer[4096];
+    for (std::size_t cnt; (cnt = std::fread(buffer, 1, sizeof(buffer), file)) != 0; )
+        content.append(buffer, cnt);
+
+    std::fclose(file);
+    return content;
+}
+
+static void put_file(Easy_ref_t &easy_ref, file_source &source, const char *dest)
+{
+    std::string url = "file://";
+    url += dest;
+
+    easy_ref.set_url(url.c_str());
+    easy_ref.request_put_file(source);
+
+    assert_same(easy_ref.perform().get_return_value(), Easy_ref_t::code::ok);
+}
+
+int main(int argc, char* argv[])
+{
+    curl::curl_t curl{nullptr};
+    assert(curl.has_protocol("file"));
+
+    char src_path[] = "/tmp/curl_cpp_test_upload_src.XXXXXX";
+    int fd = mkstemp(src_path);
+    assert(fd != -1);
+
+    std::string content;
+    for (int i = 0; i != 100000; ++i)
+        content += std::to_string(i);
+    assert_same(write(fd, content.data(), content.size()), static_cast<ssize_t>(content.size()));
+
+    const char *dest_path = "/tmp/curl_cpp_test_upload_dest";
+
+    auto easy = curl.create_easy();
+    assert(easy);
+
+    auto easy_ref = Easy_ref_t{easy.get()};
+
+    // Upload the whole file via mmap
+    {
+        auto source = file_source::create(fd).get_return_value();
+        assert(source.is_mapped());
+        assert_same(source.size(), content.size());
+
+        put_file(easy_ref, source, dest_path);
+        assert_same(read_file(dest_path), content);
+    }
+
+    // Upload a region that doesn't start at page boundary
+    {
+        auto source = file_source::create(fd, 5000, 70000).get_return_value();
+        assert(source.is_mapped());
+
+        put_file(easy_ref, source, dest_path);
+        assert_same(read_file(dest_path), content.substr(5000, 70000));
+    }
+
+    // POST a region smaller than the one uploaded above to the web server,
+    // request_post_file must undo request_put_file on the same handle
+    {
+        auto source = file_source::create(fd, 0, 4096).get_return_value();
+        assert(source.is_mapped());
+
+        easy_ref.set_url("http://localhost:8787/");
+        easy_ref.request_post_file(source);
+
+        std::string response;
+        easy_ref.set_readall_writeback(response);
+
+        assert_same(easy_ref.perform().get_return_value(), Easy_ref_t::code::ok);
+        assert_same(easy_ref.getinfo_sizeof_uploaded(), source.size());
+
+        easy_ref.set_writeback(nullptr, nullptr);
+    }
+
+    // Upload from a pipe
+    {
+        int pipefd[2];
+        assert(pipe(pipefd) == 0);
+
+        assert_same(write(pipefd[1], content.data(), 4096), static_cast<ssize_t>(4096));
+        close(pipefd[1]);
+
+        auto source = file_source::create(pipefd[0]).get_return_value();
+        assert(!source.is_mapped());
+        assert_same(source.size(), static_cast<std::size_t>(-1));
+
+        put_file(easy_ref, source, dest_path);
+        assert_same(read_file(dest_path), content.substr(0, 4096));
+
+        close(pipefd[0]);
+    }
+
+    close(fd);
+    unlink(src_path);
+    unlink(dest_path);
+
+    return 0;
+}
@@ -0,0 +1,84 @@
+#include "../curl_easy.hpp"
+
+#include <cassert>
+#include <string>
+#include <string_view>
+#include "utility.hpp"
+
+using curl::Easy_ref_t;
+
+static constexpr const auto expected_response = "<p>Hello, world!\\n</p>\n";
+
+struct Counting_sink {
+    std::size_t cnt = 0;
+    std::string data;
+
+    auto operator () (char *buffer, std::size_t size) noexcept -> std::size_t
+    {
+        ++cnt;
+        data.append(buffer, size);
+        return size;
+    }
+};
+
+struct Body_source {
+    std::string_view body;
+
+    auto operator () (char *buffer, std::size_t size) noexcept -> std::size_t
+    {
+        auto cnt = body.copy(buffer, size);
+        body.remove_prefix(cnt);
+        return cnt;
+    }
+};
+
+int main(int argc, char* argv[])
+{
+    curl::curl_t curl{nullptr};
+
+    auto easy = curl.create_easy();
+    assert(easy);
+
+    auto easy_ref = Easy_ref_t{easy.get()};
+
+    easy_ref.request_get();
+    easy_ref.set_url("http://localhost:8787/");
+
+    // string_view signature, return void
+    std::string response;
+    auto append = [&](std::string_view data) noexcept {
+        response += data;
+    };
+    easy_ref.set_writeback(append);
+
+    assert_same(easy_ref.perform().get_return_value(), Easy_ref_t::code::ok);
+    assert_same(response, std::string{expected_response});
+
+    // Stateful functor with (char*, std::size_t) signature
+    Counting_sink sink;
+    easy_ref.set_writeback(sink);
+
+    assert_same(easy_ref.perform().get_return_value(), Easy_ref_t::code::ok);
+    assert_same(sink.data, std::string{expected_response});
+    assert(sink.cnt >= 1);
+
+    // Returning 0 stops the transfer
+    auto reject = [](std::string_view) noexcept {
+        return std::size_t{0};
+    };
+    easy_ref.set_writeback(reject);
+
+    assert_same(easy_ref.perform().get_return_value(), Easy_ref_t::code::writeback_error);
+
+    // request_post with functor readback
+    std::string content = "Hello, functor!";
+    Body_source source{content};
+
+    easy_ref.request_post(source, content.size());
+    easy_ref.set_writeback(append);
+
+    assert_same(easy_ref.perform().get_return_value(), Easy_ref_t::code::ok);
+    assert(source.body.empty());
+
+    return 0;
+}
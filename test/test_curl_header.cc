@@ -0,0 +1,83 @@
+#include "../curl_easy.hpp"
+#include "../curl_header.hpp"
+
+#include <cassert>
+#include <cstring>
+#include "utility.hpp"
+
+using curl::Easy_ref_t;
+using namespace std::literals;
+
+template <class Headers>
+void feed(Headers &headers, const char *line)
+{
+    headers.parse_line(line, std::strlen(line));
+}
+
+void test_parse()
+{
+    curl::Response_headers<128, 2> headers;
+
+    feed(headers, "HTTP/1.1 301 Moved Permanently\r\n");
+    feed(headers, "Location: http://localhost/\r\n");
+    feed(headers, "\r\n");
+    assert(headers.is_complete());
+    assert_same(headers.get_status_code(), 301L);
+
+    // Malformed status codes must not overflow
+    feed(headers, "HTTP/1.1 99999999999999999999999999 OK\r\n");
+    assert_same(headers.get_status_code(), 0L);
+    feed(headers, "HTTP/1.1 42 OK\r\n");
+    assert_same(headers.get_status_code(), 0L);
+
+    // A new response discards previous one
+    feed(headers, "HTTP/2 200\r\n");
+    assert(!headers.is_complete());
+    assert_same(headers.get_version(), "HTTP/2"sv);
+    assert_same(headers.get_reason(), ""sv);
+    assert_same(headers.get_status_code(), 200L);
+    assert_same(headers.get("Location"), ""sv);
+
+    feed(headers, "ETag:   \"33a64df551425fcc55e4d42a148795d9f25f89d4\"  \r\n");
+    feed(headers, "Date: Wed, 21 Oct 2015 07:28:00 GMT\r\n");
+    feed(headers, "Retry-After: 120\r\n");
+    feed(headers, "\r\n");
+
+    assert(headers.is_complete());
+    assert(headers.is_truncated());
+    assert_same(headers.size(), 2UL);
+    assert_same(headers.get("etag"), "\"33a64df551425fcc55e4d42a148795d9f25f89d4\""sv);
+    assert_same(headers.get("DATE"), "Wed, 21 Oct 2015 07:28:00 GMT"sv);
+    assert(headers.find("Retry-After") == nullptr);
+}
+
+int main(int argc, char* argv[])
+{
+    test_parse();
+
+    curl::curl_t curl{nullptr};
+
+    auto easy = curl.create_easy();
+    assert(easy);
+
+    auto easy_ref = Easy_ref_t{easy.get()};
+
+    easy_ref.request_get();
+    easy_ref.set_url("http://localhost:8787/");
+
+    std::string response;
+    easy_ref.set_readall_writeback(response);
+
+    curl::Response_headers headers;
+    headers.attach(easy_ref);
+
+    assert_same(easy_ref.perform().get_return_value(), Easy_ref_t::code::ok);
+
+    assert(headers.is_complete());
+    assert(!headers.is_truncated());
+    assert_same(headers.get_status_code(), 200L);
+    assert_same(headers.get("content-length"), "23"sv);
+    assert_same(headers.get("CONTENT-TYPE"), "text/html"sv);
+
+    return 0;
+}
@@ -0,0 +1,77 @@
+/**
+ * Example/test for processing finished transfers in bulk via Multi_t::get_finished_easies.
+ */
+
+#include "../curl_easy.hpp"
+#include "../curl_multi.hpp"
+
+#include <cassert>
+#include <string>
+#include "utility.hpp"
+
+using curl::Easy_ref_t;
+
+static constexpr const auto connection_cnt = 20UL;
+static constexpr const auto batch_size = 4UL;
+static constexpr const auto expected_response = "<p>Hello, world!\\n</p>\n";
+
+int main(int argc, char* argv[])
+{
+    curl::curl_t curl{nullptr};
+    assert(curl.has_private_ptr_support());
+    assert(curl.has_multi_poll_support());
+
+    auto multi = curl.create_multi().get_return_value();
+    multi.set_multiplexing(30);
+
+    for (auto i = 0UL; i != connection_cnt; ++i) {
+        auto easy = curl.create_easy();
+        assert(easy);
+
+        auto easy_ref = Easy_ref_t{easy.release()};
+
+        easy_ref.request_get();
+        easy_ref.set_url("http://localhost:8787/");
+
+        auto *str = new std::string;
+        easy_ref.set_readall_writeback(*str);
+        easy_ref.set_private(str);
+
+        multi.add_easy(easy_ref);
+    }
+
+    assert_same(multi.get_number_of_handles(), connection_cnt);
+
+    std::size_t completed = 0;
+    curl::Multi_t::Finished_easy finished[batch_size];
+    do {
+        multi.perform().get_return_value();
+
+        for (std::size_t cnt; (cnt = multi.get_finished_easies(finished, batch_size)); ) {
+            assert(cnt <= batch_size);
+
+            for (auto i = 0UL; i != cnt; ++i)
+                multi.remove_easy(finished[i].easy_ref);
+
+            for (auto i = 0UL; i != cnt; ++i) {
+                auto &easy_ref = finished[i].easy_ref;
+
+                assert_same(finished[i].get_result().get_return_value(), Easy_ref_t::code::ok);
+                assert_same(easy_ref.get_response_code(), 200L);
+
+                curl::Easy_t easy{easy_ref.curl_easy};
+
+                auto *str = static_cast<std::string*>(easy_ref.get_private());
+                assert_same(*str, expected_response);
+                delete str;
+            }
+
+            completed += cnt;
+        }
+    } while (multi.break_or_poll().get_return_value() != -1);
+
+    assert_same(completed, connection_cnt);
+    assert_same(multi.get_number_of_handles(), 0UL);
+
+    return 0;
+}
@@ -0,0 +1,127 @@
+/**
+ * Example/test for using Multi_runtime.
+ */
+
+#include "../curl_easy.hpp"
+#include "../curl_multi_runtime.hpp"
+#include "../curl_share.hpp"
+
+#include <cassert>
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <string>
+#include "utility.hpp"
+
+using curl::Easy_ref_t;
+
+static constexpr const auto request_cnt = 100UL;
+static constexpr const auto expected_response = "<p>Hello, world!\\n</p>\n";
+
+struct Result {
+    std::atomic<std::size_t> completed{0};
+
+    std::mutex mutex;
+    std::set<pthread_t> threads;
+};
+
+enum class Submit {
+    round_robin,
+    /**
+     * Submit all requests to shard 0.
+     */
+    skewed,
+    by_host,
+};
+
+/**
+ * @return number of threads where requests are completed.
+ */
+auto run(curl::curl_t &curl, curl::Share_base &share, std::size_t max_inflight, Submit method)
+{
+    Result result;
+
+    curl::Multi_runtime runtime{curl, [](curl::Easy_t easy, Easy_ref_t::perform_ret_t ret, void *userp)
+    {
+        Easy_ref_t easy_ref{easy.get()};
+
+        assert_same(ret.get_return_value(), Easy_ref_t::code::ok);
+        assert_same(easy_ref.get_response_code(), 200L);
+
+        auto *str = static_cast<std::string*>(easy_ref.get_private());
+        assert_same(*str, expected_response);
+        delete str;
+
+        auto &result = *static_cast<Result*>(userp);
+        {
+            std::lock_guard guard{result.mutex};
+            result.threads.insert(pthread_self());
+        }
+        ++result.completed;
+    }, &result, 4};
+
+    runtime.set_share(&share);
+    runtime.set_multiplexing(30);
+    runtime.set_max_inflight(max_inflight);
+    runtime.start(true).get_return_value();
+
+    assert_same(runtime.get_number_of_shards(), 4UL);
+
+    for (auto i = 0UL; i != request_cnt; ++i) {
+        auto easy = curl.create_easy();
+        assert(easy);
+
+        auto easy_ref = Easy_ref_t{easy.get()};
+
+        easy_ref.request_get();
+        easy_ref.set_url("http://localhost:8787/");
+
+        auto *str = new std::string;
+        easy_ref.set_readall_writeback(*str);
+        easy_ref.set_private(str);
+
+        switch (method) {
+            case Submit::round_robin:
+                runtime.submit(easy).get_return_value();
+                break;
+
+            case Submit::skewed:
+                runtime.submit(0, easy).get_return_value();
+                break;
+
+            case Submit::by_host:
+                runtime.submit_to_host("localhost:8787", easy).get_return_value();
+                break;
+        }
+        assert(!easy);
+    }
+
+    runtime.stop();
+
+    assert_same(result.completed.load(), request_cnt);
+
+    return result.threads.size();
+}
+
+
+int main(int argc, char* argv[])
+{
+    curl::curl_t curl{nullptr};
+    assert(curl.has_private_ptr_support());
+    assert(curl.has_multi_poll_support());
+    assert(curl.has_multi_wakeup_support());
+
+    auto share = curl::Share<>{curl.create_share()};
+    share.enable_multithreaded_share();
+    share.enable_sharing(curl::Share_base::Options::dns).get_return_value();
+    share.enable_sharing(curl::Share_base::Options::ssl_session).get_return_value();
+
+    assert_same(run(curl, share, 0, Submit::round_robin), 4UL);
+
+    // Idle shards steal requests queued in shard 0
+    assert(run(curl, share, 4, Submit::skewed) > 1);
+
+    run(curl, share, 0, Submit::by_host);
+
+    return 0;
+}
@@ -0,0 +1,86 @@
+/**
+ * Example/test for using Multi_uring_t.
+ */
+
+#include "../curl_easy.hpp"
+#include "../curl_multi.hpp"
+#include "../curl_multi_uring.hpp"
+
+#include <cassert>
+#include <chrono>
+#include <string>
+#include "utility.hpp"
+
+using curl::Easy_ref_t;
+
+static constexpr const auto connection_cnt = 20UL;
+static constexpr const auto expected_response = "<p>Hello, world!\\n</p>\n";
+
+int main(int argc, char* argv[])
+{
+    curl::curl_t curl{nullptr};
+    assert(curl.has_private_ptr_support());
+    assert(curl.has_multi_socket_support());
+
+    // The kernel lacks io_uring, where Multi_epoll_t should be used instead.
+    if (!curl::Multi_uring_t::is_available())
+        return 0;
+
+    auto multi = curl.create_multi().get_return_value();
+    multi.set_multiplexing(30);
+
+    // Use a small submission queue so that it fills up.
+    curl::Multi_uring_t uring{multi, 8, 4};
+    uring.init().get_return_value();
+
+    for (auto i = 0UL; i != connection_cnt; ++i) {
+        auto easy = curl.create_easy();
+        assert(easy);
+
+        auto easy_ref = Easy_ref_t{easy.release()};
+
+        easy_ref.request_get();
+        easy_ref.set_url("http://localhost:8787/");
+
+        auto *str = new std::string;
+        easy_ref.set_readall_writeback(*str);
+        easy_ref.set_private(str);
+
+        multi.add_easy(easy_ref);
+    }
+
+    assert_same(multi.get_number_of_handles(), connection_cnt);
+
+    std::size_t completed = 0;
+    auto perform_callback = [](Easy_ref_t &easy_ref, Easy_ref_t::perform_ret_t ret, 
+                               curl::Multi_t &multi, std::size_t &completed) noexcept
+    {
+        assert_same(ret.get_return_value(), Easy_ref_t::code::ok);
+        assert_same(easy_ref.get_response_code(), 200L);
+
+        multi.remove_easy(easy_ref);
+
+        curl::Easy_t easy{easy_ref.curl_easy};
+
+        auto *str = static_cast<std::string*>(easy_ref.get_private());
+        assert_same(*str, expected_response);
+        delete str;
+
+        ++completed;
+    };
+
+    uring.start(perform_callback, completed).get_return_value();
+    while (multi.get_number_of_handles()) {
+        uring.wait(-1).get_return_value();
+        uring.perform(perform_callback, completed).get_return_value();
+    }
+
+    assert_same(completed, connection_cnt);
+
+    // Completions without any event don't end the wait early.
+    auto before = std::chrono::steady_clock::now();
+    assert_same(uring.wait(50).get_return_value(), 0UL);
+    assert(std::chrono::steady_clock::now() - before >= std::chrono::milliseconds{50});
+
+    return 0;
+}
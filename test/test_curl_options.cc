@@ -0,0 +1,79 @@
+#include "../curl_easy.hpp"
+#include "../curl_options.hpp"
+
+#include <cassert>
+#include <string>
+#include "utility.hpp"
+
+using curl::Easy_ref_t;
+namespace options = curl::options;
+
+static constexpr const auto expected_response = "<p>Hello, world!\\n</p>\n";
+
+static constexpr const char url[] = "http://localhost:8787/";
+static constexpr const char useragent[] = "curl-cpp";
+
+static constexpr const auto profile = curl::make_option_set(
+    options::url(url),
+    options::useragent(useragent),
+    options::encoding(""),
+    options::timeout(3000),
+    options::follow_location(true),
+    options::max_redirs(3)
+);
+static constexpr const auto profile2 = curl::make_option_set(
+    options::url(url),
+    options::useragent(useragent),
+    options::encoding(""),
+    options::timeout(6000),
+    options::nobody(true)
+);
+
+static_assert(profile.size() == 6);
+static_assert(profile.get_min_version() == curl::curl_t::Version::from(7, 21, 6).num);
+static_assert(profile.get_min_version() <= LIBCURL_VERSION_NUM);
+
+static_assert(!profile2.is_changed(0, profile));
+static_assert(profile2.is_changed(3, profile));
+static_assert(profile2.count_changed(profile) == 2);
+static_assert(profile.count_changed(profile) == 0);
+
+// The last one in prev is what the handle is set to
+static_assert(curl::make_option_set(options::timeout(1000)).is_changed(
+    0, curl::make_option_set(options::timeout(1000), options::timeout(2000))));
+static_assert(!curl::make_option_set(options::timeout(2000)).is_changed(
+    0, curl::make_option_set(options::timeout(1000), options::timeout(2000))));
+// All of the options with the same id are applied, so the last one wins
+static_assert(curl::make_option_set(options::timeout(2000), options::timeout(1000)).count_changed(
+    curl::make_option_set(options::timeout(1000))) == 2);
+
+int main(int argc, char* argv[])
+{
+    curl::curl_t curl{nullptr};
+    assert(profile.is_supported(curl));
+    assert(profile2.is_supported(curl));
+
+    auto easy = curl.create_easy();
+    assert(easy);
+
+    auto easy_ref = Easy_ref_t{easy.get()};
+
+    profile.apply(easy_ref).get_return_value();
+
+    std::string response;
+    easy_ref.set_readall_writeback(response);
+
+    assert_same(easy_ref.perform().get_return_value(), Easy_ref_t::code::ok);
+    assert_same(easy_ref.get_response_code(), 200L);
+    assert_same(response, std::string{expected_response});
+
+    // profile2 sets nobody
+    response.clear();
+    profile2.apply_changed(easy_ref, profile).get_return_value();
+
+    assert_same(easy_ref.perform().get_return_value(), Easy_ref_t::code::ok);
+    assert_same(easy_ref.get_response_code(), 200L);
+    assert(response.empty());
+
+    return 0;
+}
@@ -0,0 +1,66 @@
+#include "../curl_easy.hpp"
+#include "../curl_prepared_request.hpp"
+#include "../utils/header_set.hpp"
+
+#include <cassert>
+#include <string>
+#include "utility.hpp"
+
+using curl::Easy_ref_t;
+using curl::Prepared_request;
+
+static constexpr const auto expected_response = "<p>Hello, world!\\n</p>\n";
+
+static void configure(Easy_ref_t &easy_ref, void *userp)
+{
+    easy_ref.request_get();
+    easy_ref.set_timeout(3000);
+    easy_ref.set_encoding("").get_return_value();
+    easy_ref.set_readall_writeback(*static_cast<std::string*>(userp));
+}
+
+static void test_strategy(curl::curl_t &curl, Prepared_request::Strategy strategy)
+{
+    std::string response;
+    Prepared_request request{curl, configure, &response, strategy};
+
+    {
+        curl::utils::arena_slist l;
+        l.push_back("X-Test: prepared").get_return_value();
+        request.set_headers(curl::utils::header_set::create(std::move(l)).get_return_value());
+    }
+
+    request.prepare().get_return_value();
+    assert(request.get_strategy() != Prepared_request::Strategy::automatic);
+
+    for (int i = 0; i != 3; ++i) {
+        response.clear();
+
+        auto easy = request.instantiate("http://localhost:8787/").get_return_value();
+        assert(easy);
+
+        Easy_ref_t easy_ref{easy.get()};
+        assert_same(easy_ref.perform().get_return_value(), Easy_ref_t::code::ok);
+        assert_same(easy_ref.get_response_code(), 200L);
+        assert_same(response, std::string{expected_response});
+
+        // Reuse the handle
+        response.clear();
+        request.reinstantiate(easy, "http://localhost:8787/index.html").get_return_value();
+
+        assert_same(easy_ref.perform().get_return_value(), Easy_ref_t::code::ok);
+        assert_same(easy_ref.get_response_code(), 200L);
+        assert_same(response, std::string{expected_response});
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    curl::curl_t curl{nullptr};
+
+    test_strategy(curl, Prepared_request::Strategy::dup);
+    test_strategy(curl, Prepared_request::Strategy::replay);
+    test_strategy(curl, Prepared_request::Strategy::automatic);
+
+    return 0;
+}
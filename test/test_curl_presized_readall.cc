@@ -0,0 +1,84 @@
+#include "../curl_easy.hpp"
+#include "../utils/rope.hpp"
+
+#include <cassert>
+#include <string>
+#include "utility.hpp"
+
+using curl::Easy_ref_t;
+
+static constexpr const auto expected_response = "<p>Hello, world!\\n</p>\n";
+
+void test_rope()
+{
+    curl::utils::rope rope;
+    assert(rope.is_empty());
+
+    std::string data(curl::utils::rope::chunk_size + 10, 'a');
+    assert(rope.append(data.data(), data.size()));
+    assert(rope.append("bc", 2));
+    assert_same(rope.size(), data.size() + 2);
+
+    std::string result = "x";
+    rope.move_to(result);
+    assert(rope.is_empty());
+    assert_same(result, "x" + data + "bc");
+}
+
+void test_content_length()
+{
+    std::size_t content_length = 0;
+
+    constexpr const char header[] = "content-length:  1234\r\n";
+    assert(curl::utils::parse_content_length(header, sizeof(header) - 1, content_length));
+    assert_same(content_length, 1234UL);
+
+    constexpr const char invalid[] = "Content-Length: 12a\r\n";
+    assert(!curl::utils::parse_content_length(invalid, sizeof(invalid) - 1, content_length));
+
+    constexpr const char other[] = "Content-Type: text/html\r\n";
+    assert(!curl::utils::parse_content_length(other, sizeof(other) - 1, content_length));
+
+    constexpr const char status_line[] = "HTTP/1.1 301 Moved Permanently\r\n";
+    assert(curl::utils::is_status_line(status_line, sizeof(status_line) - 1));
+    assert(!curl::utils::is_status_line(other, sizeof(other) - 1));
+}
+
+int main(int argc, char* argv[])
+{
+    test_rope();
+    test_content_length();
+
+    curl::curl_t curl{nullptr};
+
+    auto easy = curl.create_easy();
+    assert(easy);
+
+    auto easy_ref = Easy_ref_t{easy.get()};
+
+    easy_ref.request_get();
+    easy_ref.set_url("http://localhost:8787/");
+
+    Easy_ref_t::Presized_readall<std::string> arg;
+    easy_ref.set_presized_readall_writeback(arg);
+
+    assert_same(easy_ref.perform().get_return_value(), Easy_ref_t::code::ok);
+    assert_same(easy_ref.get_response_code(), 200L);
+
+    // Server sends Content-Length, thus no data should be put into rope.
+    assert(arg.rest.is_empty());
+    assert_same(arg.response, expected_response);
+
+    // Content-Length beyond max_reserve is not trusted.
+    Easy_ref_t::Presized_readall<std::string> clamped;
+    clamped.max_reserve = 4;
+    easy_ref.set_presized_readall_writeback(clamped);
+
+    assert_same(easy_ref.perform().get_return_value(), Easy_ref_t::code::ok);
+    assert(!clamped.rest.is_empty());
+
+    clamped.rest.move_to(clamped.response);
+    assert_same(clamped.response, expected_response);
+
+    return 0;
+}
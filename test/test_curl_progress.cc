@@ -0,0 +1,89 @@
+#include "../curl_easy.hpp"
+#include "../curl_progress.hpp"
+
+#include <cassert>
+#include <string>
+#include <thread>
+#include "utility.hpp"
+
+using curl::Easy_ref_t;
+using curl::Progress_sampler;
+
+struct Sampler: Progress_sampler {
+    using Progress_sampler::Progress_sampler;
+    using Progress_sampler::update;
+};
+
+static constexpr const auto expected_response = "<p>Hello, world!\\n</p>\n";
+
+int main(int argc, char* argv[])
+{
+    curl::curl_t curl{nullptr};
+    assert(curl.has_xferinfo_support());
+
+    auto easy = curl.create_easy();
+    assert(easy);
+
+    auto easy_ref = Easy_ref_t{easy.get()};
+
+    easy_ref.request_get();
+    easy_ref.set_url("http://localhost:8787/");
+
+    std::string response;
+    easy_ref.set_readall_writeback(response);
+
+    // Sample every progress update and only keep track of transfer rate
+    Progress_sampler sampler{std::chrono::milliseconds{0}};
+    sampler.attach(easy_ref);
+
+    assert_same(easy_ref.perform().get_return_value(), Easy_ref_t::code::ok);
+    assert_same(easy_ref.get_response_code(), 200L);
+    assert_same(response, std::string{expected_response});
+
+    assert_same(sampler.get_sample().dl_now, response.size());
+    assert(sampler.get_sample().dl_rate >= 0);
+
+    // Abort the transfer in the callback
+    std::size_t cnt = 0;
+    auto abort_transfer = [&](const Progress_sampler::Sample &sample) {
+        ++cnt;
+        return Progress_sampler::action::abort;
+    };
+    sampler.set_callback(abort_transfer);
+    sampler.attach(easy_ref);
+
+    assert_same(easy_ref.perform().get_return_value(), Easy_ref_t::code::aborted_by_callback);
+    assert_same(cnt, 1UL);
+
+    // The callback is never called if min_bytes is not reached
+    Progress_sampler throttled{std::chrono::milliseconds{0}, 1024 * 1024};
+    throttled.set_callback(abort_transfer);
+    throttled.attach(easy_ref);
+
+    response.clear();
+    assert_same(easy_ref.perform().get_return_value(), Easy_ref_t::code::ok);
+    assert_same(response, std::string{expected_response});
+    assert_same(cnt, 1UL);
+
+    throttled.detach(easy_ref);
+
+    // Counters going backwards, e.g. on redirect, restart the measurement
+    Sampler restarted{std::chrono::milliseconds{0}};
+    restarted.attach(easy_ref);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    restarted.update(0, 1000, 0, 0);
+    assert_same(restarted.get_sample().dl_now, 1000UL);
+
+    restarted.update(0, 10, 0, 0);
+    assert_same(restarted.get_sample().dl_now, 10UL);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    restarted.update(0, 20, 0, 0);
+    assert_same(restarted.get_sample().dl_now, 20UL);
+    assert(restarted.get_sample().dl_rate <= 1000 * 1000);
+
+    restarted.detach(easy_ref);
+
+    return 0;
+}
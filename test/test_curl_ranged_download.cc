@@ -0,0 +1,253 @@
+#include "../curl_ranged_download.hpp"
+
+#include <atomic>
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include "utility.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+using curl::Ranged_download;
+
+static constexpr const auto block_size = 4096UL;
+
+static auto read_file(const char *path) -> std::string
+{
+    std::string content;
+
+    FILE *file = std::fopen(path, "rb");
+    assert(file);
+
+    char buffer[4096];
+    for (std::size_t cnt; (cnt = std::fread(buffer, 1, sizeof(buffer), file)) != 0; )
+        content.append(buffer, cnt);
+
+    std::fclose(file);
+    return content;
+}
+static void write_file(const char *path, const std::string &content)
+{
+    FILE *file = std::fopen(path, "wb");
+    assert(file);
+    assert_same(std::fwrite(content.data(), 1, content.size(), file), content.size());
+    std::fclose(file);
+}
+
+static void download(curl::curl_t &curl, const std::string &content, int out_fd, int state_fd)
+{
+    auto multi = curl.create_multi().get_return_value();
+
+    Ranged_download download{curl, multi, "http://localhost:8787/ranged_download.bin", 
+                             content.size(), block_size};
+    download.open(out_fd, state_fd).get_return_value();
+    download.start(8).get_return_value();
+
+    do {
+        download.perform().get_return_value();
+        assert(!download.has_failed());
+    } while (!download.is_finished() && multi.poll(nullptr, 0, 1000).get_return_value() >= 0);
+
+    assert_same(download.get_number_of_completed_blocks(), download.get_number_of_blocks());
+}
+
+/**
+ * Serves range requests of content, one connection at a time, and drops
+ * the connection halfway through the body of the first drop_cnt responses.
+ */
+struct Flaky_server {
+    const std::string &content;
+    std::atomic<unsigned> drop_cnt{0};
+
+    int listen_fd = -1;
+    pthread_t thread;
+    char url[64];
+
+    Flaky_server(const std::string &content_arg) noexcept:
+        content{content_arg}
+    {
+        listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+        assert(listen_fd != -1);
+
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        assert_same(bind(listen_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)), 0);
+        assert_same(listen(listen_fd, 64), 0);
+
+        socklen_t len = sizeof(addr);
+        assert_same(getsockname(listen_fd, reinterpret_cast<sockaddr*>(&addr), &len), 0);
+        std::snprintf(url, sizeof(url), "http://127.0.0.1:%d/", ntohs(addr.sin_port));
+
+        assert_same(pthread_create(&thread, nullptr, serve, this), 0);
+    }
+
+    static void send_all(int fd, const char *data, std::size_t len) noexcept
+    {
+        for (ssize_t cnt; len != 0 && (cnt = send(fd, data, len, MSG_NOSIGNAL)) > 0; len -= cnt)
+            data += cnt;
+    }
+
+    static void* serve(void *arg) noexcept
+    {
+        auto &server = *static_cast<Flaky_server*>(arg);
+
+        for (int fd; (fd = accept(server.listen_fd, nullptr, nullptr)) != -1; close(fd)) {
+            char request[4096];
+            std::size_t len = 0;
+            while (len != sizeof(request) - 1) {
+                ssize_t cnt = recv(fd, request + len, sizeof(request) - 1 - len, 0);
+                if (cnt <= 0)
+                    break;
+                len += cnt;
+                request[len] = '\0';
+                if (std::strstr(request, "\r\n\r\n"))
+                    break;
+            }
+            request[len] = '\0';
+
+            const char *range = std::strstr(request, "Range: bytes=");
+            std::size_t first, last;
+            if (!range || std::sscanf(range, "Range: bytes=%zu-%zu", &first, &last) != 2)
+                continue;
+
+            std::size_t body_len = last - first + 1;
+
+            char header[256];
+            int header_len = std::snprintf(header, sizeof(header), 
+                                           "HTTP/1.1 206 Partial Content\r\n"
+                                           "Content-Range: bytes %zu-%zu/%zu\r\n"
+                                           "Content-Length: %zu\r\n"
+                                           "Connection: close\r\n\r\n",
+                                           first, last, server.content.size(), body_len);
+            send_all(fd, header, header_len);
+
+            if (server.drop_cnt.load() != 0) {
+                --server.drop_cnt;
+                body_len /= 2;
+            }
+            send_all(fd, server.content.data() + first, body_len);
+        }
+
+        return nullptr;
+    }
+
+    ~Flaky_server()
+    {
+        // Wake up accept()
+        shutdown(listen_fd, SHUT_RDWR);
+        assert_same(pthread_join(thread, nullptr), 0);
+        close(listen_fd);
+    }
+};
+
+/**
+ * @return true if the download is finished, false if it failed.
+ */
+static bool download_flaky(curl::curl_t &curl, Flaky_server &server, int out_fd, unsigned max_retries)
+{
+    auto multi = curl.create_multi().get_return_value();
+
+    Ranged_download download{curl, multi, server.url, server.content.size(), block_size};
+    download.set_max_retries(max_retries);
+    download.open(out_fd).get_return_value();
+    download.start(2).get_return_value();
+
+    do {
+        download.perform().get_return_value();
+        if (download.has_failed())
+            return false;
+    } while (!download.is_finished() && multi.poll(nullptr, 0, 1000).get_return_value() >= 0);
+
+    return download.is_finished();
+}
+
+int main(int argc, char* argv[])
+{
+    curl::curl_t curl{nullptr};
+    assert(curl.has_private_ptr_support());
+    assert(curl.has_multi_poll_support());
+
+    std::string content;
+    for (int i = 0; i != 100000; ++i)
+        content += std::to_string(i);
+
+    // Served by the web server
+    const char *src_path = "web_server/ranged_download.bin";
+    write_file(src_path, content);
+
+    const char *out_path = "/tmp/curl_cpp_test_ranged_download";
+    const char *state_path = "/tmp/curl_cpp_test_ranged_download.state";
+
+    int out_fd = open(out_path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    assert(out_fd != -1);
+
+    download(curl, content, out_fd, -1);
+    assert_same(read_file(out_path), content);
+
+    // Resume from the state file, where even blocks are marked as completed,
+    // thus only odd blocks are downloaded.
+    int state_fd = open(state_path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    assert(state_fd != -1);
+
+    {
+        auto multi = curl.create_multi().get_return_value();
+
+        Ranged_download download{curl, multi, "", content.size(), block_size};
+        download.open(out_fd, state_fd).get_return_value();
+        assert_same(download.get_number_of_completed_blocks(), 0UL);
+    }
+
+    std::string state = read_file(state_path);
+    for (std::size_t i = 24; i != state.size(); ++i)
+        state[i] = static_cast<char>(0x55);
+    write_file(state_path, state);
+
+    ftruncate(out_fd, 0);
+
+    download(curl, content, out_fd, state_fd);
+
+    auto result = read_file(out_path);
+    assert_same(result.size(), content.size());
+    for (std::size_t i = 0; i < content.size(); i += block_size) {
+        std::size_t block = i / block_size;
+        auto expected = block % 2 == 1 ? content.substr(i, block_size) : 
+                                         std::string(std::min(block_size, content.size() - i), '\0');
+        assert_same(result.substr(i, block_size), expected);
+    }
+
+    // Ranges whose connection is dropped are retried from where they stopped
+    {
+        Flaky_server server{content};
+        server.drop_cnt = 3;
+
+        ftruncate(out_fd, 0);
+        assert(download_flaky(curl, server, out_fd, 3));
+        assert_same(server.drop_cnt.load(), 0U);
+        assert_same(read_file(out_path), content);
+    }
+
+    // ... until max_retries is exceeded
+    {
+        Flaky_server server{content};
+        server.drop_cnt = 1;
+
+        ftruncate(out_fd, 0);
+        assert(!download_flaky(curl, server, out_fd, 0));
+    }
+
+    close(out_fd);
+    close(state_fd);
+
+    unlink(src_path);
+    unlink(out_path);
+    unlink(state_path);
+
+    return 0;
+}
@@ -0,0 +1,76 @@
+#include "../curl_easy.hpp"
+#include "../utils/ring_buffer.hpp"
+
+#include <cassert>
+#include <string>
+#include "utility.hpp"
+
+using curl::Easy_ref_t;
+using curl::utils::ring_buffer;
+
+static constexpr const auto expected_response = "<p>Hello, world!\\n</p>\n";
+
+void test_wraparound()
+{
+    char buffer[8];
+    ring_buffer ring{buffer, sizeof(buffer)};
+
+    assert(ring.write("abcdef", 6));
+    assert(!ring.write("ghi", 3));
+    assert_same(ring.peek(), std::string_view{"abcdef"});
+
+    ring.consume(4);
+    assert(ring.write("ghij", 4));
+    assert_same(ring.size(), 6UL);
+
+    // Readable data wraps around in non-mirrored mode
+    assert_same(ring.peek(), std::string_view{"efgh"});
+    ring.consume(4);
+    assert_same(ring.peek(), std::string_view{"ij"});
+    ring.consume(2);
+    assert(ring.is_empty());
+}
+
+void test_mirrored_wraparound()
+{
+    auto ring = ring_buffer::create_mirrored(1).get_return_value();
+    assert(ring.is_mirrored());
+
+    auto capacity = ring.get_capacity();
+    std::string data(capacity - 2, 'a');
+
+    assert(ring.write(data.data(), data.size()));
+    ring.consume(data.size() - 1);
+    assert(ring.write("bcd", 3));
+
+    // Readable data is always contiguous in mirrored mode
+    assert_same(ring.peek(), std::string_view{"abcd"});
+}
+
+int main(int argc, char* argv[])
+{
+    test_wraparound();
+    test_mirrored_wraparound();
+
+    curl::curl_t curl{nullptr};
+    assert(curl.has_pause_support());
+
+    auto ring = ring_buffer::create_mirrored(CURL_MAX_WRITE_SIZE).get_return_value();
+
+    auto easy = curl.create_easy();
+    assert(easy);
+
+    auto easy_ref = Easy_ref_t{easy.get()};
+
+    easy_ref.request_get();
+    easy_ref.set_url("http://localhost:8787/");
+    easy_ref.set_ring_writeback(ring);
+
+    assert_same(easy_ref.perform().get_return_value(), Easy_ref_t::code::ok);
+    assert_same(easy_ref.get_response_code(), 200L);
+
+    assert(!ring.is_paused());
+    assert_same(ring.peek(), std::string_view{expected_response});
+
+    return 0;
+}
@@ -0,0 +1,114 @@
+/**
+ * Example/test for using Submission_queue.
+ */
+
+#include "../curl_easy.hpp"
+#include "../curl_multi.hpp"
+#include "../curl_submission_queue.hpp"
+
+#include <cassert>
+#include <string>
+#include <pthread.h>
+#include "utility.hpp"
+
+using curl::Easy_ref_t;
+
+static constexpr const auto producer_cnt = 4UL;
+static constexpr const auto requests_per_producer = 25UL;
+static constexpr const auto expected_response = "<p>Hello, world!\\n</p>\n";
+
+struct Producer {
+    curl::curl_t *curl;
+    curl::Submission_queue *queue;
+    pthread_t thread;
+};
+
+void* produce(void *arg) noexcept
+{
+    auto &producer = *static_cast<Producer*>(arg);
+
+    for (auto i = 0UL; i != requests_per_producer; ++i) {
+        auto easy = producer.curl->create_easy();
+        assert(easy);
+
+        auto easy_ref = Easy_ref_t{easy.get()};
+
+        easy_ref.request_get();
+        easy_ref.set_url("http://localhost:8787/");
+
+        auto *str = new std::string;
+        easy_ref.set_readall_writeback(*str);
+        easy_ref.set_private(str);
+
+        producer.queue->push(easy).get_return_value();
+        assert(!easy);
+    }
+
+    return nullptr;
+}
+
+void run(curl::curl_t &curl, bool use_eventfd)
+{
+    auto multi = curl.create_multi().get_return_value();
+
+    curl::Submission_queue queue{multi};
+    curl_waitfd waitfd{};
+    if (use_eventfd) {
+        queue.enable_eventfd().get_return_value();
+
+        waitfd.fd = queue.get_eventfd();
+        waitfd.events = CURL_WAIT_POLLIN;
+    } else
+        assert_same(queue.get_eventfd(), -1);
+
+    Producer producers[producer_cnt];
+    for (auto &producer: producers) {
+        producer = Producer{&curl, &queue, {}};
+        assert_same(pthread_create(&producer.thread, nullptr, produce, &producer), 0);
+    }
+
+    std::size_t completed = 0;
+    auto perform_callback = [](Easy_ref_t &easy_ref, Easy_ref_t::perform_ret_t ret,
+                               curl::Multi_t &multi, std::size_t &completed) noexcept
+    {
+        assert_same(ret.get_return_value(), Easy_ref_t::code::ok);
+        assert_same(easy_ref.get_response_code(), 200L);
+
+        multi.remove_easy(easy_ref);
+
+        curl::Easy_t easy{easy_ref.curl_easy};
+
+        auto *str = static_cast<std::string*>(easy_ref.get_private());
+        assert_same(*str, expected_response);
+        delete str;
+
+        ++completed;
+    };
+
+    while (completed != producer_cnt * requests_per_producer) {
+        queue.drain();
+        multi.perform(perform_callback, completed).get_return_value();
+        if (use_eventfd)
+            multi.poll(&waitfd, 1, 1000).get_return_value();
+        else
+            multi.poll(nullptr, 0, 1000).get_return_value();
+    }
+
+    for (auto &producer: producers)
+        assert_same(pthread_join(producer.thread, nullptr), 0);
+
+    assert_same(queue.drain(), 0UL);
+    assert_same(multi.get_number_of_handles(), 0UL);
+}
+
+int main(int argc, char* argv[])
+{
+    curl::curl_t curl{nullptr};
+    assert(curl.has_multi_poll_support());
+    assert(curl.has_multi_wakeup_support());
+
+    run(curl, false);
+    run(curl, true);
+
+    return 0;
+}
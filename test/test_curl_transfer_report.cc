@@ -0,0 +1,62 @@
+/**
+ * Example/test for using Easy_ref_t::getinfo_transfer_report.
+ */
+
+#include "../curl_easy.hpp"
+
+#include <cassert>
+#include <string>
+#include "utility.hpp"
+
+using curl::Easy_ref_t;
+
+static constexpr const auto expected_response = "<p>Hello, world!\\n</p>\n";
+
+void check_report(const Easy_ref_t::Transfer_report &report)
+{
+    assert(report.namelookup_time <= report.connect_time);
+    assert(report.connect_time <= report.pretransfer_time);
+    assert(report.pretransfer_time <= report.starttransfer_time);
+    assert(report.starttransfer_time <= report.total_time);
+    assert(report.total_time > 0);
+
+    // Plain http, no redirection
+    assert_same(report.appconnect_time, 0UL);
+    assert_same(report.redirect_time, 0UL);
+    assert_same(report.redirect_count, 0L);
+}
+
+int main(int argc, char* argv[])
+{
+    curl::curl_t curl{nullptr};
+
+    auto easy = curl.create_easy();
+    assert(easy);
+
+    auto easy_ref = Easy_ref_t{easy.get()};
+
+    easy_ref.request_get();
+    easy_ref.set_url("http://localhost:8787/");
+
+    std::string response;
+    easy_ref.set_readall_writeback(response);
+
+    assert_same(easy_ref.perform().get_return_value(), Easy_ref_t::code::ok);
+    assert_same(easy_ref.get_response_code(), 200L);
+    assert_same(response, expected_response);
+
+    auto report = easy_ref.getinfo_transfer_report(curl);
+    check_report(report);
+    assert_same(report.num_connects, 1L);
+
+    // The connection is reused
+    response.clear();
+    assert_same(easy_ref.perform().get_return_value(), Easy_ref_t::code::ok);
+    assert_same(response, expected_response);
+
+    report = easy_ref.getinfo_transfer_report(curl);
+    check_report(report);
+    assert_same(report.num_connects, 0L);
+
+    return 0;
+}
@@ -40,6 +40,11 @@ try {
 
     assert_same(std::string_view{url_ref2.get_url().get_return_value().get()}, "https://wwww.google.com/"sv);
     assert_same(std::string_view{url_ref2.get_scheme().get_return_value().get()}, "https"sv);
+    assert_same(std::string_view{url_ref2.get_host().get_return_value().get()}, "wwww.google.com"sv);
+
+    url_ref2.get_port().Catch([](get_code code) noexcept {
+        assert_same(code, get_code::no_port);
+    });
 
     url_ref2.get_options().Catch([](get_code code) noexcept {
         assert_same(code, get_code::no_options);
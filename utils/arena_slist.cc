@@ -0,0 +1,190 @@
+#include "arena_slist.hpp"
+#include <curl/curl.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <utility>
+#include <algorithm>
+
+namespace curl::utils {
+static constexpr const std::size_t min_capacity = 256;
+
+static auto get_entry_size(std::size_t len) noexcept -> std::size_t
+{
+    constexpr const std::size_t align = alignof(curl_slist);
+    return (sizeof(curl_slist) + len + 1 + align - 1) / align * align;
+}
+
+/**
+ * Replace next of every node except the last one with its offset from block.
+ *
+ * Nodes are stored in block in order, and the first one is at offset 0.
+ */
+static void to_offsets(char *block, std::size_t tail_offset) noexcept
+{
+    for (std::size_t offset = 0; offset != tail_offset; ) {
+        auto *node = reinterpret_cast<curl_slist*>(block + offset);
+        offset = reinterpret_cast<char*>(node->next) - block;
+        node->next = reinterpret_cast<curl_slist*>(static_cast<std::uintptr_t>(offset));
+    }
+}
+/**
+ * Reverse of to_offsets, and point data of every node into block.
+ */
+static void from_offsets(char *block, std::size_t tail_offset) noexcept
+{
+    for (std::size_t offset = 0; ; ) {
+        auto *node = reinterpret_cast<curl_slist*>(block + offset);
+        node->data = reinterpret_cast<char*>(node + 1);
+
+        if (offset == tail_offset)
+            break;
+
+        offset = reinterpret_cast<std::uintptr_t>(node->next);
+        node->next = reinterpret_cast<curl_slist*>(block + offset);
+    }
+}
+
+arena_slist::arena_slist(arena_slist &&other) noexcept
+{
+    (*this).swap(other);
+}
+arena_slist& arena_slist::operator = (arena_slist &&other) noexcept
+{
+    arena_slist{std::move(other)}.swap(*this);
+    return *this;
+}
+
+void arena_slist::swap(arena_slist &other) noexcept
+{
+    std::swap(block, other.block);
+    std::swap(capacity, other.capacity);
+    std::swap(used, other.used);
+    std::swap(head, other.head);
+    std::swap(tail, other.tail);
+    std::swap(cnt, other.cnt);
+    std::swap(link, other.link);
+}
+void arena_slist::clear() noexcept
+{
+    used = 0;
+    head = nullptr;
+    tail = nullptr;
+    cnt = 0;
+}
+
+arena_slist::~arena_slist()
+{
+    std::free(block);
+}
+
+void arena_slist::set_link(void *next) noexcept
+{
+    link = next;
+    if (tail)
+        static_cast<curl_slist*>(tail)->next = static_cast<curl_slist*>(next);
+}
+
+bool arena_slist::is_empty() const noexcept
+{
+    return get_underlying_ptr() == nullptr;
+}
+auto arena_slist::size() const noexcept -> std::size_t
+{
+    return cnt;
+}
+
+auto arena_slist::begin() const noexcept -> const_iterator
+{
+    return {get_underlying_ptr()};
+}
+auto arena_slist::end() const noexcept -> const_iterator
+{
+    return {};
+}
+
+auto arena_slist::cbegin() const noexcept -> const_iterator
+{
+    return {get_underlying_ptr()};
+}
+auto arena_slist::cend() const noexcept -> const_iterator
+{
+    return {};
+}
+
+auto arena_slist::get_underlying_ptr() const noexcept -> void*
+{
+    return head ? head : link;
+}
+
+bool arena_slist::grow(std::size_t new_capacity) noexcept
+{
+    if (new_capacity <= capacity)
+        return true;
+
+    new_capacity = std::max({new_capacity, 2 * capacity, min_capacity});
+
+    // Pointers into the block are converted to offsets before realloc,
+    // since the old block must not be accessed once realloc moves it.
+    const std::size_t tail_offset = tail ? static_cast<char*>(tail) - block : 0;
+    if (head)
+        to_offsets(block, tail_offset);
+
+    char *new_block = static_cast<char*>(std::realloc(block, new_capacity));
+    if (!new_block) {
+        if (head)
+            from_offsets(block, tail_offset);
+        return false;
+    }
+
+    block = new_block;
+    capacity = new_capacity;
+
+    if (head) {
+        from_offsets(block, tail_offset);
+        head = block;
+        tail = block + tail_offset;
+    }
+
+    return true;
+}
+
+auto arena_slist::reserve(std::size_t bytes) noexcept -> Ret_except<void, std::bad_alloc>
+{
+    if (!grow(bytes))
+        return {std::bad_alloc{}};
+    return {};
+}
+
+auto arena_slist::push_back(const char *str) noexcept -> Ret_except<void, std::bad_alloc>
+{
+    return push_back(str, std::strlen(str));
+}
+auto arena_slist::push_back(const char *str, std::size_t len) noexcept -> Ret_except<void, std::bad_alloc>
+{
+    std::size_t entry_size = get_entry_size(len);
+    if (!grow(used + entry_size))
+        return {std::bad_alloc{}};
+
+    auto *node = reinterpret_cast<curl_slist*>(block + used);
+    char *data = reinterpret_cast<char*>(node + 1);
+
+    std::memcpy(data, str, len);
+    data[len] = '\0';
+
+    node->data = data;
+    node->next = static_cast<curl_slist*>(link);
+
+    if (tail)
+        static_cast<curl_slist*>(tail)->next = node;
+    else
+        head = node;
+    tail = node;
+
+    used += entry_size;
+    ++cnt;
+
+    return {};
+}
+} /* namespace curl::utils */
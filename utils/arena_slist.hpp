@@ -0,0 +1,120 @@
+#ifndef  __curl_cpp_utils_arena_slist_HPP__
+# define __curl_cpp_utils_arena_slist_HPP__
+
+# include <cstddef>
+# include <new>
+
+# include "curl_slist.hpp"
+# include "../return-exception/ret-exception.hpp"
+
+namespace curl::utils {
+/**
+ * Drop-in replacement of utils::slist, which stores all nodes and
+ * strings in one contiguous block of memory.
+ *
+ * Each node of struct curl_slist is immediately followed by its string,
+ * thus push_back is a memcpy most of the time and iterating over the list
+ * walks memory sequentially.
+ *
+ * The whole list is freed in one operation and clear() keeps the block,
+ * so rebuilding the list for every request does not allocate in steady state.
+ *
+ * Thread-safety: same as utils::slist.
+ */
+class arena_slist {
+protected:
+    char *block = nullptr;
+    std::size_t capacity = 0;
+    std::size_t used = 0;
+
+    void *head = nullptr;
+    void *tail = nullptr;
+    std::size_t cnt = 0;
+
+    /**
+     * next of the last element, which is outside of the memory block.
+     */
+    void *link = nullptr;
+
+    /**
+     * @param next struct curl_slist* which the last element of this list links to.
+     *             <br>It is not owned by this list.
+     */
+    void set_link(void *next) noexcept;
+
+    /**
+     * @return false if out of memory.
+     */
+    bool grow(std::size_t min_capacity) noexcept;
+
+public:
+    using value_type = slist::value_type;
+
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    using reference = value_type&;
+    using const_reference = const value_type&;
+
+    using pointer = value_type*;
+    using const_pointer = const value_type*;
+
+    using const_iterator = slist::const_iterator;
+
+    arena_slist() = default;
+
+    arena_slist(const arena_slist&) = delete;
+    arena_slist(arena_slist &&other) noexcept;
+
+    arena_slist& operator = (const arena_slist&) = delete;
+    arena_slist& operator = (arena_slist &&other) noexcept;
+
+    void swap(arena_slist &other) noexcept;
+    /**
+     * Remove all elements, but keep the memory block for reuse.
+     */
+    void clear() noexcept;
+
+    ~arena_slist();
+
+    bool is_empty() const noexcept;
+    /**
+     * @return number of elements stored in this list.
+     */
+    auto size() const noexcept -> std::size_t;
+
+    auto begin() const noexcept -> const_iterator;
+    auto end() const noexcept -> const_iterator;
+
+    auto cbegin() const noexcept -> const_iterator;
+    auto cend() const noexcept -> const_iterator;
+
+    /**
+     * Get underlying struct curl_slist* pointer.
+     *
+     * It is invalidated by push_back() or reserve() that grows the memory block,
+     * so you must call curl::Easy_ref_t::set_http_header again after modifing the list.
+     */
+    auto get_underlying_ptr() const noexcept -> void*;
+
+    /**
+     * @param bytes size of memory block to preallocate.
+     *              <br>Each element takes sizeof(struct curl_slist) + strlen(str) + 1 bytes,
+     *              rounded up to alignment of struct curl_slist.
+     */
+    auto reserve(std::size_t bytes) noexcept -> Ret_except<void, std::bad_alloc>;
+
+    /**
+     * @param str is copied into the memory block.
+     *            Must not be CRLF-terminated for use in curl::Easy_ref_t::set_http_header.
+     */
+    auto push_back(const char *str) noexcept -> Ret_except<void, std::bad_alloc>;
+    /**
+     * @param str need not to be null-terminated.
+     * @param len length of str
+     */
+    auto push_back(const char *str, std::size_t len) noexcept -> Ret_except<void, std::bad_alloc>;
+};
+} /* namespace curl::utils */
+
+#endif
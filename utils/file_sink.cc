@@ -0,0 +1,182 @@
+#include "file_sink.hpp"
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+#include <algorithm>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+namespace curl::utils {
+static auto make_errno_error(const char *what) noexcept
+{
+    if (errno == ENOMEM)
+        return Ret_except<file_sink, std::bad_alloc, std::system_error>{std::bad_alloc{}};
+    return Ret_except<file_sink, std::bad_alloc, std::system_error>{
+        std::system_error{errno, std::generic_category(), what}
+    };
+}
+auto file_sink::create(int fd, bool resume, bool direct, std::size_t buffer_size) noexcept ->
+    Ret_except<file_sink, std::bad_alloc, std::system_error>
+{
+    buffer_size = std::max((buffer_size + alignment - 1) / alignment * alignment, alignment);
+
+    file_sink sink;
+    sink.fd = fd;
+
+    if (resume) {
+        struct stat st;
+        if (fstat(fd, &st) == -1)
+            return make_errno_error("In curl::utils::file_sink::create: fstat failed");
+
+        sink.resume_offset = st.st_size;
+        if (direct)
+            sink.resume_offset = sink.resume_offset / alignment * alignment;
+        sink.offset = sink.resume_offset;
+    }
+
+    if (direct) {
+        int flags = fcntl(fd, F_GETFL);
+        if (flags == -1 || fcntl(fd, F_SETFL, flags | O_DIRECT) == -1)
+            return make_errno_error("In curl::utils::file_sink::create: failed to enable O_DIRECT");
+        sink.direct = true;
+    }
+
+    void *buffer;
+    if (posix_memalign(&buffer, alignment, buffer_size) != 0)
+        return {std::bad_alloc{}};
+
+    sink.buffer = static_cast<char*>(buffer);
+    sink.capacity = buffer_size;
+
+    return {std::move(sink)};
+}
+
+file_sink::file_sink(file_sink &&other) noexcept
+{
+    (*this).swap(other);
+}
+file_sink& file_sink::operator = (file_sink &&other) noexcept
+{
+    file_sink{std::move(other)}.swap(*this);
+    return *this;
+}
+
+void file_sink::swap(file_sink &other) noexcept
+{
+    std::swap(fd, other.fd);
+    std::swap(buffer, other.buffer);
+    std::swap(capacity, other.capacity);
+    std::swap(len, other.len);
+    std::swap(offset, other.offset);
+    std::swap(resume_offset, other.resume_offset);
+    std::swap(expected_size, other.expected_size);
+    std::swap(direct, other.direct);
+    std::swap(error, other.error);
+}
+
+file_sink::~file_sink()
+{
+    std::free(buffer);
+}
+
+bool file_sink::is_direct() const noexcept
+{
+    return direct;
+}
+
+auto file_sink::get_resume_offset() const noexcept -> std::size_t
+{
+    return resume_offset;
+}
+auto file_sink::size() const noexcept -> std::size_t
+{
+    return offset + len;
+}
+int file_sink::get_error() const noexcept
+{
+    return error;
+}
+
+void file_sink::restart() noexcept
+{
+    len = 0;
+    offset = 0;
+    resume_offset = 0;
+    expected_size = 0;
+    error = 0;
+}
+
+bool file_sink::preallocate(std::size_t total) noexcept
+{
+    if (total <= size())
+        return true;
+    return fallocate(fd, FALLOC_FL_KEEP_SIZE, size(), total - size()) == 0;
+}
+void file_sink::set_expected_size(std::size_t total) noexcept
+{
+    expected_size = total;
+}
+
+bool file_sink::flush_buffer() noexcept
+{
+    for (std::size_t written = 0; written != len; ) {
+        ssize_t cnt = pwrite(fd, buffer + written, len - written, offset + written);
+        if (cnt == -1) {
+            if (errno == EINTR)
+                continue;
+            error = errno;
+            return false;
+        }
+        written += cnt;
+    }
+
+    offset += len;
+    len = 0;
+
+    return true;
+}
+
+bool file_sink::write(const char *data, std::size_t n) noexcept
+{
+    if (expected_size != 0) {
+        preallocate(expected_size);
+        expected_size = 0;
+    }
+
+    while (n != 0) {
+        std::size_t cnt = std::min(n, capacity - len);
+        std::memcpy(buffer + len, data, cnt);
+
+        len += cnt;
+        data += cnt;
+        n -= cnt;
+
+        if (len == capacity && !flush_buffer())
+            return false;
+    }
+    return true;
+}
+
+auto file_sink::finish() noexcept -> Ret_except<void, std::system_error>
+{
+    if (direct && len % alignment != 0) {
+        int flags = fcntl(fd, F_GETFL);
+        if (flags == -1 || fcntl(fd, F_SETFL, flags & ~O_DIRECT) == -1)
+            return {std::system_error{errno, std::generic_category(),
+                                      "In curl::utils::file_sink::finish: failed to disable O_DIRECT"}};
+        direct = false;
+    }
+
+    if (!flush_buffer())
+        return {std::system_error{error, std::generic_category(), "In curl::utils::file_sink::finish: pwrite failed"}};
+
+    if (ftruncate(fd, offset) == -1)
+        return {std::system_error{errno, std::generic_category(), "In curl::utils::file_sink::finish: ftruncate failed"}};
+
+    return {};
+}
+} /* namespace curl::utils */
@@ -0,0 +1,133 @@
+#ifndef  __curl_cpp_utils_file_sink_HPP__
+# define __curl_cpp_utils_file_sink_HPP__
+
+# include <cstddef>
+# include <new>
+# include <system_error>
+
+# include "../return-exception/ret-exception.hpp"
+
+namespace curl::utils {
+/**
+ * Write-only sink of a file, designed to be used as the writeback of
+ * curl::Easy_ref_t::set_file_writeback.
+ *
+ * Data written is coalesced in a page-aligned buffer and written to the file
+ * by pwrite() only when the buffer is full, so libcurl's small chunks
+ * become large aligned writes.
+ *
+ * It can optionally resume a partially downloaded file and
+ * bypass the page cache via O_DIRECT.
+ *
+ * The fd is not owned by file_sink and must be kept open until it is destroyed.
+ *
+ * Thread-safety: it is not thread-safe.
+ */
+class file_sink {
+protected:
+    int fd = -1;
+
+    char *buffer = nullptr;
+    std::size_t capacity = 0;
+    std::size_t len = 0;
+
+    /**
+     * Offset in file where buffer[0] is written to.
+     */
+    std::size_t offset = 0;
+    std::size_t resume_offset = 0;
+    /**
+     * Preallocated by the next write() if not 0.
+     */
+    std::size_t expected_size = 0;
+
+    bool direct = false;
+    int error = 0;
+
+    bool flush_buffer() noexcept;
+
+public:
+    /**
+     * Alignment of buffer, offset and length of writes.
+     */
+    static constexpr const std::size_t alignment = 4096;
+
+    file_sink() = default;
+
+    /**
+     * @param fd must be opened for writing and must not be opened with O_APPEND.
+     * @param resume if true, data is appended to the existing content of the file
+     *               and get_resume_offset() is the size of the file,
+     *               which is rounded down to alignment if direct == true.
+     *               <br>Otherwise, data is written from the start of the file.
+     * @param direct if true, O_DIRECT is enabled on fd.
+     *               <br>std::system_error is returned if the file system doesn't support it.
+     * @param buffer_size would be rounded up to multiple of alignment.
+     */
+    static auto create(int fd, bool resume = false, bool direct = false,
+                       std::size_t buffer_size = 1024 * 1024) noexcept ->
+        Ret_except<file_sink, std::bad_alloc, std::system_error>;
+
+    file_sink(const file_sink&) = delete;
+    file_sink(file_sink &&other) noexcept;
+
+    file_sink& operator = (const file_sink&) = delete;
+    file_sink& operator = (file_sink &&other) noexcept;
+
+    void swap(file_sink &other) noexcept;
+
+    ~file_sink();
+
+    bool is_direct() const noexcept;
+
+    /**
+     * @return offset in file where the download starts.
+     */
+    auto get_resume_offset() const noexcept -> std::size_t;
+    /**
+     * @return size of the file, including data not yet written.
+     */
+    auto size() const noexcept -> std::size_t;
+    /**
+     * @return errno of the last failed write, or 0.
+     */
+    int get_error() const noexcept;
+
+    /**
+     * Discard everything and start writing from the start of the file,
+     * e.g. if the server doesn't support resuming.
+     */
+    void restart() noexcept;
+
+    /**
+     * Preallocate disk space for the file without changing its size.
+     *
+     * @param total expected size of the file.
+     * @return false if it failed, which is harmless except that
+     *         the file might be more fragmented.
+     */
+    bool preallocate(std::size_t total) noexcept;
+    /**
+     * Call preallocate(total) on the next write() instead, so that nothing is
+     * preallocated if no data follows, e.g. for the body of a redirect.
+     *
+     * @param total pass 0 to cancel.
+     */
+    void set_expected_size(std::size_t total) noexcept;
+
+    /**
+     * @return false on error, in which case get_error() is set.
+     */
+    bool write(const char *data, std::size_t n) noexcept;
+
+    /**
+     * Write all data in buffer to file and truncate the file to size().
+     *
+     * If is_direct() and size() is not aligned, then O_DIRECT is disabled
+     * before writing the last block.
+     */
+    auto finish() noexcept -> Ret_except<void, std::system_error>;
+};
+} /* namespace curl::utils */
+
+#endif
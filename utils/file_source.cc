@@ -0,0 +1,143 @@
+#include "file_source.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <utility>
+#include <algorithm>
+
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace curl::utils {
+static auto make_errno_error(const char *what) noexcept
+{
+    if (errno == ENOMEM)
+        return Ret_except<file_source, std::bad_alloc, std::system_error>{std::bad_alloc{}};
+    return Ret_except<file_source, std::bad_alloc, std::system_error>{
+        std::system_error{errno, std::generic_category(), what}
+    };
+}
+auto file_source::create(int fd, std::size_t offset, std::size_t len) noexcept ->
+    Ret_except<file_source, std::bad_alloc, std::system_error>
+{
+    struct stat st;
+    if (fstat(fd, &st) == -1)
+        return make_errno_error("In curl::utils::file_source::create: fstat failed");
+
+    file_source source;
+    source.fd = fd;
+
+    if (!S_ISREG(st.st_mode)) {
+        source.len = len;
+        return {std::move(source)};
+    }
+
+    const std::size_t file_size = st.st_size;
+    if (offset > file_size) {
+        errno = EINVAL;
+        return make_errno_error("In curl::utils::file_source::create: offset is beyond end of file");
+    }
+
+    source.offset = offset;
+    source.len = std::min(len, file_size - offset);
+    source.seekable = true;
+
+    if (source.len == 0)
+        return {std::move(source)};
+
+    const std::size_t page_size = sysconf(_SC_PAGESIZE);
+    const std::size_t map_offset = offset / page_size * page_size;
+    const std::size_t map_len = source.len + (offset - map_offset);
+
+    void *addr = mmap(nullptr, map_len, PROT_READ, MAP_PRIVATE, fd, map_offset);
+    if (addr == MAP_FAILED) {
+        if (errno == ENOMEM)
+            return {std::bad_alloc{}};
+        // Fallback to pread
+        return {std::move(source)};
+    }
+
+    madvise(addr, map_len, MADV_SEQUENTIAL);
+
+    source.map_addr = static_cast<char*>(addr);
+    source.map_len = map_len;
+    source.data = source.map_addr + (offset - map_offset);
+
+    return {std::move(source)};
+}
+
+file_source::file_source(file_source &&other) noexcept
+{
+    (*this).swap(other);
+}
+file_source& file_source::operator = (file_source &&other) noexcept
+{
+    file_source{std::move(other)}.swap(*this);
+    return *this;
+}
+
+void file_source::swap(file_source &other) noexcept
+{
+    std::swap(fd, other.fd);
+    std::swap(offset, other.offset);
+    std::swap(len, other.len);
+    std::swap(pos, other.pos);
+    std::swap(map_addr, other.map_addr);
+    std::swap(map_len, other.map_len);
+    std::swap(data, other.data);
+    std::swap(seekable, other.seekable);
+}
+
+file_source::~file_source()
+{
+    if (map_addr)
+        munmap(map_addr, map_len);
+}
+
+bool file_source::is_mapped() const noexcept
+{
+    return map_addr != nullptr;
+}
+auto file_source::size() const noexcept -> std::size_t
+{
+    return len;
+}
+
+auto file_source::read(char *buffer, std::size_t n) noexcept -> std::size_t
+{
+    if (len != static_cast<std::size_t>(-1))
+        n = std::min(n, len - pos);
+    if (n == 0)
+        return 0;
+
+    if (data) {
+        std::memcpy(buffer, data + pos, n);
+        pos += n;
+        return n;
+    }
+
+    ssize_t cnt;
+    do {
+        if (seekable)
+            cnt = pread(fd, buffer, n, offset + pos);
+        else
+            cnt = ::read(fd, buffer, n);
+    } while (cnt == -1 && errno == EINTR);
+
+    if (cnt == -1)
+        return -1;
+
+    pos += cnt;
+    return cnt;
+}
+
+bool file_source::seek(std::size_t new_pos) noexcept
+{
+    if (!seekable || new_pos > len)
+        return false;
+
+    pos = new_pos;
+    return true;
+}
+} /* namespace curl::utils */
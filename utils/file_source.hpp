@@ -0,0 +1,92 @@
+#ifndef  __curl_cpp_utils_file_source_HPP__
+# define __curl_cpp_utils_file_source_HPP__
+
+# include <cstddef>
+# include <new>
+# include <system_error>
+
+# include "../return-exception/ret-exception.hpp"
+
+namespace curl::utils {
+/**
+ * Read-only view of a region of a file, designed to be used as the request body of
+ * curl::Easy_ref_t::request_post_file and curl::Easy_ref_t::request_put_file.
+ *
+ * If fd refers to a regular file, the region is mmap-ed with MADV_SEQUENTIAL, so that
+ * libcurl's upload buffer is filled straight from the page cache without read().
+ * <br>Otherwise (pipes, sockets, character devices, or the file cannot be mmap-ed),
+ * it falls back to read() the region chunk by chunk.
+ *
+ * The fd is not owned by file_source and must be kept open until it is destroyed.
+ * <br>The file must not be truncated while it is mapped, otherwise SIGBUS would be raised.
+ * <br>In the fallback mode, fd must be in blocking mode.
+ *
+ * Thread-safety: it is not thread-safe.
+ */
+class file_source {
+protected:
+    int fd = -1;
+    std::size_t offset = 0;
+    /**
+     * -1 if unknown.
+     */
+    std::size_t len = 0;
+    std::size_t pos = 0;
+
+    /**
+     * Start of the mapping, which is page-aligned and thus can be before the region.
+     */
+    char *map_addr = nullptr;
+    std::size_t map_len = 0;
+    /**
+     * Start of the region in the mapping.
+     */
+    const char *data = nullptr;
+
+    bool seekable = false;
+
+public:
+    file_source() = default;
+
+    /**
+     * @param offset where the region starts.
+     *               <br>Ignored if fd is not seekable, in which case data is read from
+     *               the current position of fd.
+     * @param len length of the region.
+     *            <br>If set to -1, then the region extends to the end of file for regular files,
+     *            or is unknown for other types of fd.
+     */
+    static auto create(int fd, std::size_t offset = 0, std::size_t len = -1) noexcept ->
+        Ret_except<file_source, std::bad_alloc, std::system_error>;
+
+    file_source(const file_source&) = delete;
+    file_source(file_source &&other) noexcept;
+
+    file_source& operator = (const file_source&) = delete;
+    file_source& operator = (file_source &&other) noexcept;
+
+    void swap(file_source &other) noexcept;
+
+    ~file_source();
+
+    bool is_mapped() const noexcept;
+    /**
+     * @return length of the region, or -1 if unknown.
+     */
+    auto size() const noexcept -> std::size_t;
+
+    /**
+     * @return number of bytes copied to buffer, 0 on end of region,
+     *         or -1 on error, in which case errno is set.
+     */
+    auto read(char *buffer, std::size_t n) noexcept -> std::size_t;
+
+    /**
+     * @param pos relative to the start of the region
+     * @return false if the region cannot be seeked or pos is beyond the region.
+     */
+    bool seek(std::size_t pos) noexcept;
+};
+} /* namespace curl::utils */
+
+#endif
@@ -0,0 +1,89 @@
+#include "header_set.hpp"
+
+#include <atomic>
+#include <utility>
+
+namespace curl::utils {
+struct header_set::control {
+    std::atomic<std::size_t> refcnt;
+    arena_slist list;
+};
+
+auto header_set::create(arena_slist &&l) noexcept -> Ret_except<header_set, std::bad_alloc>
+{
+    auto *ctl = new (std::nothrow) control{{1}, std::move(l)};
+    if (!ctl)
+        return {std::bad_alloc{}};
+
+    header_set set;
+    set.ctl = ctl;
+    return {std::move(set)};
+}
+
+header_set::header_set(const header_set &other) noexcept:
+    ctl{other.ctl}
+{
+    if (ctl)
+        ctl->refcnt.fetch_add(1, std::memory_order_relaxed);
+}
+header_set::header_set(header_set &&other) noexcept
+{
+    (*this).swap(other);
+}
+
+header_set& header_set::operator = (const header_set &other) noexcept
+{
+    header_set{other}.swap(*this);
+    return *this;
+}
+header_set& header_set::operator = (header_set &&other) noexcept
+{
+    header_set{std::move(other)}.swap(*this);
+    return *this;
+}
+
+void header_set::swap(header_set &other) noexcept
+{
+    std::swap(ctl, other.ctl);
+}
+
+header_set::~header_set()
+{
+    if (ctl && ctl->refcnt.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        delete ctl;
+}
+
+bool header_set::is_empty() const noexcept
+{
+    return !ctl || ctl->list.is_empty();
+}
+
+auto header_set::begin() const noexcept -> const_iterator
+{
+    return {get_underlying_ptr()};
+}
+auto header_set::end() const noexcept -> const_iterator
+{
+    return {};
+}
+
+auto header_set::get_underlying_ptr() const noexcept -> void*
+{
+    return ctl ? ctl->list.get_underlying_ptr() : nullptr;
+}
+
+header_overlay::header_overlay(header_set base_arg) noexcept
+{
+    set_base(std::move(base_arg));
+}
+
+void header_overlay::set_base(header_set base_arg) noexcept
+{
+    base = std::move(base_arg);
+    set_link(base.get_underlying_ptr());
+}
+auto header_overlay::get_base() const noexcept -> const header_set&
+{
+    return base;
+}
+} /* namespace curl::utils */
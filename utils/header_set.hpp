@@ -0,0 +1,93 @@
+#ifndef  __curl_cpp_utils_header_set_HPP__
+# define __curl_cpp_utils_header_set_HPP__
+
+# include <cstddef>
+# include <new>
+
+# include "arena_slist.hpp"
+# include "../return-exception/ret-exception.hpp"
+
+namespace curl::utils {
+/**
+ * Immutable, reference-counted list of headers that can be
+ * shared among threads and requests.
+ *
+ * It is meant to hold headers common to most requests, e.g. authorization,
+ * user-agent and tracing headers, with per-request headers added via header_overlay.
+ *
+ * Thread-safety: copying, destroying and reading header_set can be done
+ * from multiple threads simultaneously, as long as each thread uses its own
+ * header_set object.
+ */
+class header_set {
+protected:
+    struct control;
+
+    control *ctl = nullptr;
+
+public:
+    using const_iterator = arena_slist::const_iterator;
+
+    /**
+     * Construct an empty header_set that holds no headers.
+     */
+    header_set() = default;
+
+    /**
+     * @param l would be moved into the returned header_set and can not be
+     *          modified any more.
+     */
+    static auto create(arena_slist &&l) noexcept -> Ret_except<header_set, std::bad_alloc>;
+
+    header_set(const header_set &other) noexcept;
+    header_set(header_set &&other) noexcept;
+
+    header_set& operator = (const header_set &other) noexcept;
+    header_set& operator = (header_set &&other) noexcept;
+
+    void swap(header_set &other) noexcept;
+
+    ~header_set();
+
+    bool is_empty() const noexcept;
+
+    auto begin() const noexcept -> const_iterator;
+    auto end() const noexcept -> const_iterator;
+
+    /**
+     * Get underlying struct curl_slist* pointer.
+     */
+    auto get_underlying_ptr() const noexcept -> void*;
+};
+
+/**
+ * Per-request headers linked in front of a shared header_set.
+ *
+ * Headers in header_set are not copied: the last header pushed to this list
+ * links to the first header of header_set, thus building the list costs
+ * O(number of headers in the overlay).
+ *
+ * Since it is a utils::arena_slist, it can be passed to curl::Easy_ref_t::set_http_header
+ * directly, and it can be clear()-ed and reused for the next request.
+ *
+ * If the overlay and header_set contain header of the same name, both are sent.
+ *
+ * Thread-safety: same as utils::slist.
+ */
+class header_overlay: public arena_slist {
+protected:
+    header_set base;
+
+public:
+    header_overlay() = default;
+    header_overlay(header_set base) noexcept;
+
+    header_overlay(header_overlay&&) = default;
+    header_overlay& operator = (header_overlay&&) = default;
+
+    void set_base(header_set base) noexcept;
+    auto get_base() const noexcept -> const header_set&;
+};
+} /* namespace curl::utils */
+
+#endif
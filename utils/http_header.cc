@@ -0,0 +1,53 @@
+#include "http_header.hpp"
+
+#include <cstring>
+#include <strings.h>
+#include <limits>
+
+namespace curl::utils {
+static bool is_space(char c) noexcept
+{
+    return c == ' ' || c == '\t';
+}
+
+bool parse_content_length(const char *line, std::size_t len, std::size_t &content_length) noexcept
+{
+    constexpr const char name[] = "Content-Length:";
+    constexpr const std::size_t name_len = sizeof(name) - 1;
+
+    if (len < name_len || strncasecmp(line, name, name_len) != 0)
+        return false;
+
+    std::size_t i = name_len;
+    while (i != len && is_space(line[i]))
+        ++i;
+
+    if (i == len || line[i] < '0' || line[i] > '9')
+        return false;
+
+    constexpr const auto max = std::numeric_limits<std::size_t>::max();
+
+    std::size_t value = 0;
+    for (; i != len && line[i] >= '0' && line[i] <= '9'; ++i) {
+        std::size_t digit = line[i] - '0';
+        if (value > (max - digit) / 10)
+            return false;
+        value = value * 10 + digit;
+    }
+
+    for (; i != len; ++i)
+        if (!is_space(line[i]) && line[i] != '\r' && line[i] != '\n')
+            return false;
+
+    content_length = value;
+    return true;
+}
+
+bool is_status_line(const char *line, std::size_t len) noexcept
+{
+    constexpr const char prefix[] = "HTTP/";
+    constexpr const std::size_t prefix_len = sizeof(prefix) - 1;
+
+    return len >= prefix_len && std::memcmp(line, prefix, prefix_len) == 0;
+}
+} /* namespace curl::utils */
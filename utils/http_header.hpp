@@ -0,0 +1,24 @@
+#ifndef  __curl_cpp_utils_http_header_HPP__
+# define __curl_cpp_utils_http_header_HPP__
+
+# include <cstddef>
+
+namespace curl::utils {
+/**
+ * @param line a single header line passed to header writeback,
+ *             not null-terminated.
+ * @param content_length set only if true is returned.
+ * @return true if line is a valid "Content-Length" header (name is matched case-insensitively).
+ */
+bool parse_content_length(const char *line, std::size_t len, std::size_t &content_length) noexcept;
+/**
+ * @param line a single header line passed to header writeback,
+ *             not null-terminated.
+ * @return true if line is the status line of a response, which
+ *         is passed to header writeback once for each response received
+ *         (including redirects and 1xx responses).
+ */
+bool is_status_line(const char *line, std::size_t len) noexcept;
+} /* namespace curl::utils */
+
+#endif
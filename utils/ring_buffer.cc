@@ -0,0 +1,175 @@
+#include "ring_buffer.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <cassert>
+#include <utility>
+#include <algorithm>
+
+#include <unistd.h>
+#include <sys/mman.h>
+
+namespace curl::utils {
+ring_buffer::ring_buffer(char *buffer_arg, std::size_t capacity_arg) noexcept:
+    buffer{buffer_arg},
+    capacity{capacity_arg}
+{
+    assert(capacity != 0);
+}
+
+static auto make_errno_error(const char *what) noexcept
+{
+    if (errno == ENOMEM)
+        return Ret_except<ring_buffer, std::bad_alloc, std::system_error>{std::bad_alloc{}};
+    return Ret_except<ring_buffer, std::bad_alloc, std::system_error>{
+        std::system_error{errno, std::generic_category(), what}
+    };
+}
+auto ring_buffer::create_mirrored(std::size_t capacity) noexcept ->
+    Ret_except<ring_buffer, std::bad_alloc, std::system_error>
+{
+    const std::size_t page_size = sysconf(_SC_PAGESIZE);
+    capacity = (capacity + page_size - 1) / page_size * page_size;
+    if (capacity == 0)
+        capacity = page_size;
+
+    int fd = memfd_create("curl::utils::ring_buffer", MFD_CLOEXEC);
+    if (fd == -1)
+        return make_errno_error("In curl::utils::ring_buffer::create_mirrored: memfd_create failed");
+
+    if (ftruncate(fd, capacity) == -1) {
+        auto ret = make_errno_error("In curl::utils::ring_buffer::create_mirrored: ftruncate failed");
+        close(fd);
+        return ret;
+    }
+
+    // Reserve address space for both mappings first, so that they are guaranteed to be adjacent.
+    void *addr = mmap(nullptr, 2 * capacity, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (addr == MAP_FAILED) {
+        auto ret = make_errno_error("In curl::utils::ring_buffer::create_mirrored: mmap failed");
+        close(fd);
+        return ret;
+    }
+
+    char *base = static_cast<char*>(addr);
+    for (char *p: {base, base + capacity}) {
+        if (mmap(p, capacity, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED) {
+            auto ret = make_errno_error("In curl::utils::ring_buffer::create_mirrored: mmap failed");
+            munmap(addr, 2 * capacity);
+            close(fd);
+            return ret;
+        }
+    }
+
+    // The mappings keep the memory file alive.
+    close(fd);
+
+    ring_buffer ring{base, capacity};
+    ring.mirrored = true;
+    return {std::move(ring)};
+}
+
+ring_buffer::ring_buffer(ring_buffer &&other) noexcept
+{
+    (*this).swap(other);
+}
+ring_buffer& ring_buffer::operator = (ring_buffer &&other) noexcept
+{
+    ring_buffer{std::move(other)}.swap(*this);
+    return *this;
+}
+
+void ring_buffer::swap(ring_buffer &other) noexcept
+{
+    std::swap(buffer, other.buffer);
+    std::swap(capacity, other.capacity);
+    std::swap(head, other.head);
+    std::swap(len, other.len);
+    std::swap(mirrored, other.mirrored);
+    std::swap(paused, other.paused);
+}
+
+ring_buffer::~ring_buffer()
+{
+    if (mirrored)
+        munmap(buffer, 2 * capacity);
+}
+
+auto ring_buffer::get_capacity() const noexcept -> std::size_t
+{
+    return capacity;
+}
+auto ring_buffer::size() const noexcept -> std::size_t
+{
+    return len;
+}
+auto ring_buffer::get_free_space() const noexcept -> std::size_t
+{
+    return capacity - len;
+}
+
+bool ring_buffer::is_empty() const noexcept
+{
+    return len == 0;
+}
+bool ring_buffer::is_mirrored() const noexcept
+{
+    return mirrored;
+}
+
+auto ring_buffer::peek() const noexcept -> std::string_view
+{
+    if (mirrored)
+        return {buffer + head, len};
+    else
+        return {buffer + head, std::min(len, capacity - head)};
+}
+void ring_buffer::consume(std::size_t n) noexcept
+{
+    assert(n <= len);
+
+    len -= n;
+    head += n;
+    if (head >= capacity)
+        head -= capacity;
+
+    // Rewind to reduce the chance of wraparound in non-mirrored mode.
+    if (len == 0)
+        head = 0;
+}
+void ring_buffer::clear() noexcept
+{
+    head = 0;
+    len = 0;
+}
+
+bool ring_buffer::write(const char *data, std::size_t n) noexcept
+{
+    if (n > capacity - len)
+        return false;
+
+    std::size_t tail = head + len;
+    if (tail >= capacity)
+        tail -= capacity;
+
+    if (mirrored)
+        std::memcpy(buffer + tail, data, n);
+    else {
+        std::size_t first = std::min(n, capacity - tail);
+        std::memcpy(buffer + tail, data, first);
+        std::memcpy(buffer, data + first, n - first);
+    }
+
+    len += n;
+    return true;
+}
+
+bool ring_buffer::is_paused() const noexcept
+{
+    return paused;
+}
+void ring_buffer::set_paused(bool paused_arg) noexcept
+{
+    paused = paused_arg;
+}
+} /* namespace curl::utils */
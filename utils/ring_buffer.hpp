@@ -0,0 +1,104 @@
+#ifndef  __curl_cpp_utils_ring_buffer_HPP__
+# define __curl_cpp_utils_ring_buffer_HPP__
+
+# include <cstddef>
+# include <new>
+# include <string_view>
+# include <system_error>
+
+# include "../return-exception/ret-exception.hpp"
+
+namespace curl::utils {
+/**
+ * Fixed-capacity byte ring buffer, designed to be used as a
+ * sink of curl::Easy_ref_t::set_ring_writeback.
+ *
+ * The storage is either:
+ *  - supplied by the caller, in which case the readable data can wrap around
+ *    the end of the buffer and peek() has to be called twice to read it all;
+ *  - an mmap-ed region mapped twice back-to-back (see create_mirrored), in which case
+ *    the readable data is always contiguous.
+ *
+ * Thread-safety: it is not thread-safe.
+ */
+class ring_buffer {
+protected:
+    char *buffer = nullptr;
+    std::size_t capacity = 0;
+    /**
+     * Offset of the first readable byte, always < capacity.
+     */
+    std::size_t head = 0;
+    std::size_t len = 0;
+
+    bool mirrored = false;
+    bool paused = false;
+
+public:
+    ring_buffer() = default;
+
+    /**
+     * @param buffer must be kept around until this ring_buffer is destroyed.
+     * @param capacity must be > 0
+     */
+    ring_buffer(char *buffer, std::size_t capacity) noexcept;
+
+    /**
+     * @param capacity would be rounded up to multiple of page size.
+     *
+     * Creates an anonymous memory file and maps it twice back-to-back,
+     * so that any readable or writable region is contiguous in memory.
+     */
+    static auto create_mirrored(std::size_t capacity) noexcept ->
+        Ret_except<ring_buffer, std::bad_alloc, std::system_error>;
+
+    ring_buffer(const ring_buffer&) = delete;
+    ring_buffer(ring_buffer &&other) noexcept;
+
+    ring_buffer& operator = (const ring_buffer&) = delete;
+    ring_buffer& operator = (ring_buffer &&other) noexcept;
+
+    void swap(ring_buffer &other) noexcept;
+
+    ~ring_buffer();
+
+    auto get_capacity() const noexcept -> std::size_t;
+    /**
+     * @return number of readable bytes
+     */
+    auto size() const noexcept -> std::size_t;
+    auto get_free_space() const noexcept -> std::size_t;
+
+    bool is_empty() const noexcept;
+    bool is_mirrored() const noexcept;
+
+    /**
+     * @return the contiguous readable bytes starting from the head.
+     *         <br>If !is_mirrored() and the readable data wraps around, this is only
+     *         the part before the end of buffer.
+     *
+     * The view is invalidated by consume() and clear().
+     */
+    auto peek() const noexcept -> std::string_view;
+    /**
+     * @param n must be <= size()
+     */
+    void consume(std::size_t n) noexcept;
+    void clear() noexcept;
+
+    /**
+     * @return true if all n bytes are written;
+     *         false if there isn't enough free space, in which case nothing is written.
+     */
+    bool write(const char *data, std::size_t n) noexcept;
+
+    /**
+     * @return true if the writeback installed by curl::Easy_ref_t::set_ring_writeback
+     *         has paused the transfer since this ring is full.
+     */
+    bool is_paused() const noexcept;
+    void set_paused(bool paused) noexcept;
+};
+} /* namespace curl::utils */
+
+#endif
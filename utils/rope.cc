@@ -0,0 +1,141 @@
+#include "rope.hpp"
+
+#include <new>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+#include <algorithm>
+
+namespace curl::utils {
+struct rope::chunk {
+    chunk *next;
+    std::size_t size;
+    std::size_t capacity;
+
+    auto get_data() noexcept -> char*
+    {
+        return reinterpret_cast<char*>(this + 1);
+    }
+};
+
+rope::rope(rope &&other) noexcept
+{
+    (*this).swap(other);
+}
+rope& rope::operator = (rope &&other) noexcept
+{
+    clear();
+    (*this).swap(other);
+
+    return *this;
+}
+
+void rope::swap(rope &other) noexcept
+{
+    std::swap(head, other.head);
+    std::swap(tail, other.tail);
+    std::swap(len, other.len);
+}
+void rope::clear() noexcept
+{
+    for (chunk *curr = head; curr; ) {
+        chunk *next = curr->next;
+        std::free(curr);
+        curr = next;
+    }
+
+    head = nullptr;
+    tail = nullptr;
+    len = 0;
+}
+
+rope::~rope()
+{
+    clear();
+}
+
+bool rope::is_empty() const noexcept
+{
+    return len == 0;
+}
+auto rope::size() const noexcept -> std::size_t
+{
+    return len;
+}
+
+auto rope::const_iterator::operator ++ () noexcept -> const_iterator&
+{
+    chunk_ptr = static_cast<const chunk*>(chunk_ptr)->next;
+    return *this;
+}
+auto rope::const_iterator::operator ++ (int) noexcept -> const_iterator
+{
+    auto ret = *this;
+    ++(*this);
+    return ret;
+}
+auto rope::const_iterator::operator * () const noexcept -> value_type
+{
+    auto *c = const_cast<chunk*>(static_cast<const chunk*>(chunk_ptr));
+    return {c->get_data(), c->size};
+}
+bool operator == (const rope::const_iterator &x, const rope::const_iterator &y) noexcept
+{
+    return x.chunk_ptr == y.chunk_ptr;
+}
+bool operator != (const rope::const_iterator &x, const rope::const_iterator &y) noexcept
+{
+    return x.chunk_ptr != y.chunk_ptr;
+}
+
+auto rope::begin() const noexcept -> const_iterator
+{
+    return {head};
+}
+auto rope::end() const noexcept -> const_iterator
+{
+    return {};
+}
+
+bool rope::append(const char *data, std::size_t n) noexcept
+{
+    std::size_t first = 0;
+    if (tail) {
+        first = std::min(n, tail->capacity - tail->size);
+        std::memcpy(tail->get_data() + tail->size, data, first);
+        tail->size += first;
+    }
+
+    std::size_t rest = n - first;
+    if (rest != 0) {
+        std::size_t capacity = std::max(rest, chunk_size);
+
+        void *p = std::malloc(sizeof(chunk) + capacity);
+        if (!p) {
+            if (tail)
+                tail->size -= first;
+            return false;
+        }
+
+        auto *c = new (p) chunk{nullptr, rest, capacity};
+        std::memcpy(c->get_data(), data + first, rest);
+
+        if (tail)
+            tail->next = c;
+        else
+            head = c;
+        tail = c;
+    }
+
+    len += n;
+    return true;
+}
+
+void rope::copy_to(char *buffer) const noexcept
+{
+    for (std::string_view data: *this) {
+        std::memcpy(buffer, data.data(), data.size());
+        buffer += data.size();
+    }
+}
+} /* namespace curl::utils */
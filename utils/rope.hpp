@@ -0,0 +1,104 @@
+#ifndef  __curl_cpp_utils_rope_HPP__
+# define __curl_cpp_utils_rope_HPP__
+
+# include <cstddef>
+# include <iterator>
+# include <string_view>
+
+namespace curl::utils {
+/**
+ * Append-only byte string stored as a singly-linked list of
+ * fixed-size chunks.
+ *
+ * Unlike std::string, appending to rope never moves data already stored,
+ * so it is suitable for buffering data of unknown length.
+ *
+ * Thread-safety: same as utils::slist.
+ */
+class rope {
+protected:
+    struct chunk;
+
+    chunk *head = nullptr;
+    chunk *tail = nullptr;
+    std::size_t len = 0;
+
+public:
+    /**
+     * Minimal size of data a chunk can hold.
+     */
+    static constexpr const std::size_t chunk_size = 64 * 1024;
+
+    struct const_iterator {
+        const void *chunk_ptr = nullptr;
+
+        using value_type = std::string_view;
+        using pointer = value_type*;
+        using reference = value_type&;
+        using difference_type = std::ptrdiff_t;
+        using iterator_category = std::forward_iterator_tag;
+
+        auto operator ++ () noexcept -> const_iterator&;
+        auto operator ++ (int) noexcept -> const_iterator;
+
+        /**
+         * @return data stored in the chunk
+         */
+        auto operator * () const noexcept -> value_type;
+
+        friend bool operator == (const const_iterator &x, const const_iterator &y) noexcept;
+        friend bool operator != (const const_iterator &x, const const_iterator &y) noexcept;
+    };
+
+    rope() = default;
+
+    rope(const rope&) = delete;
+    rope(rope &&other) noexcept;
+
+    rope& operator = (const rope&) = delete;
+    rope& operator = (rope &&other) noexcept;
+
+    void swap(rope &other) noexcept;
+    /**
+     * Free all chunks.
+     */
+    void clear() noexcept;
+
+    ~rope();
+
+    bool is_empty() const noexcept;
+    auto size() const noexcept -> std::size_t;
+
+    /**
+     * Iterate over chunks.
+     */
+    auto begin() const noexcept -> const_iterator;
+    auto end() const noexcept -> const_iterator;
+
+    /**
+     * @return false if out of memory, in which case nothing is appended.
+     */
+    bool append(const char *data, std::size_t n) noexcept;
+
+    /**
+     * @param buffer must be at least size() long.
+     */
+    void copy_to(char *buffer) const noexcept;
+
+    /**
+     * Append all data to str, then clear().
+     *
+     * str would be reserve()-ed once, thus it is reallocated at most once.
+     */
+    template <class String>
+    void move_to(String &str)
+    {
+        str.reserve(str.size() + size());
+        for (std::string_view data: *this)
+            str.append(data.data(), data.data() + data.size());
+        clear();
+    }
+};
+} /* namespace curl::utils */
+
+#endif
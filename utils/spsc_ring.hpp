@@ -0,0 +1,147 @@
+#ifndef  __curl_cpp_utils_spsc_ring_HPP__
+# define __curl_cpp_utils_spsc_ring_HPP__
+
+# include <cstddef>
+# include <cstdlib>
+# include <atomic>
+# include <new>
+# include <type_traits>
+
+# include "../return-exception/ret-exception.hpp"
+
+namespace curl::utils {
+/**
+ * Bounded lock-free single-producer single-consumer ring of T.
+ *
+ * The producer and the consumer each own one index, kept on separate cache lines,
+ * and cache the index of the other side so that it is only reloaded when the ring
+ * looks full (or empty).
+ *
+ * Thread-safety: push() can only be called by one thread and pop() by another
+ * thread at a time.
+ */
+template <class T>
+class spsc_ring {
+    static_assert(std::is_trivially_copyable_v<T>);
+
+protected:
+    static constexpr const std::size_t cacheline_size = 64;
+
+    T *slots = nullptr;
+    std::size_t mask = 0;
+
+    /**
+     * Written by the consumer.
+     */
+    alignas(cacheline_size) std::atomic<std::size_t> head{0};
+    std::size_t cached_tail = 0;
+
+    /**
+     * Written by the producer.
+     */
+    alignas(cacheline_size) std::atomic<std::size_t> tail{0};
+    std::size_t cached_head = 0;
+
+public:
+    spsc_ring() = default;
+
+    spsc_ring(const spsc_ring&) = delete;
+    spsc_ring& operator = (const spsc_ring&) = delete;
+
+    /**
+     * @param capacity would be rounded up to power of 2, must be > 0.
+     *
+     * Must be called once before any push() or pop().
+     */
+    auto init(std::size_t capacity) noexcept -> Ret_except<void, std::bad_alloc>
+    {
+        std::size_t size = 1;
+        while (size < capacity)
+            size *= 2;
+
+        slots = static_cast<T*>(std::malloc(size * sizeof(T)));
+        if (!slots)
+            return {std::bad_alloc{}};
+        mask = size - 1;
+
+        return {};
+    }
+
+    ~spsc_ring()
+    {
+        std::free(slots);
+    }
+
+    auto get_capacity() const noexcept -> std::size_t
+    {
+        return slots ? mask + 1 : 0;
+    }
+    /**
+     * @return number of elements, only exact if called by the producer
+     *         or the consumer while the other side is inactive.
+     */
+    auto size() const noexcept -> std::size_t
+    {
+        return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+    }
+
+    /**
+     * Can only be called by the producer.
+     *
+     * @return number of elements pushed, less than n if the ring is full.
+     */
+    auto push(const T *items, std::size_t n) noexcept -> std::size_t
+    {
+        const std::size_t t = tail.load(std::memory_order_relaxed);
+
+        std::size_t room = mask + 1 - (t - cached_head);
+        if (room < n) {
+            cached_head = head.load(std::memory_order_acquire);
+            room = mask + 1 - (t - cached_head);
+        }
+        if (n > room)
+            n = room;
+
+        for (std::size_t i = 0; i != n; ++i)
+            slots[(t + i) & mask] = items[i];
+
+        tail.store(t + n, std::memory_order_release);
+        return n;
+    }
+    /**
+     * Can only be called by the producer.
+     *
+     * @return false if the ring is full.
+     */
+    bool push(const T &item) noexcept
+    {
+        return push(&item, 1) == 1;
+    }
+
+    /**
+     * Can only be called by the consumer.
+     *
+     * @return number of elements popped into out.
+     */
+    auto pop(T *out, std::size_t n) noexcept -> std::size_t
+    {
+        const std::size_t h = head.load(std::memory_order_relaxed);
+
+        std::size_t avail = cached_tail - h;
+        if (avail < n) {
+            cached_tail = tail.load(std::memory_order_acquire);
+            avail = cached_tail - h;
+        }
+        if (n > avail)
+            n = avail;
+
+        for (std::size_t i = 0; i != n; ++i)
+            out[i] = slots[(h + i) & mask];
+
+        head.store(h + n, std::memory_order_release);
+        return n;
+    }
+};
+} /* namespace curl::utils */
+
+#endif